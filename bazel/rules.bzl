@@ -1,4 +1,4 @@
-load("@rules_cc//cc:defs.bzl", "cc_library", "cc_test")
+load("@rules_cc//cc:defs.bzl", "cc_binary", "cc_library", "cc_test")
 load(
     "@local_config//:defs.bzl",
     "PROJECT_DEFAULT_COPTS",
@@ -31,3 +31,15 @@ def opt_cc_test(name, **kwargs):
         deps = full_deps,
         **kwargs
     )
+
+def opt_cc_benchmark(name, deps = [], srcs = None, **kwargs):
+    cc_binary(
+        name = name,
+        srcs = srcs or [name + "_bench.cpp"],
+        copts = PROJECT_DEFAULT_COPTS,
+        deps = [
+            "//:optimizer",
+            "@com_github_google_benchmark//:benchmark_main",
+        ] + deps,
+        **kwargs
+    )
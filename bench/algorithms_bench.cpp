@@ -0,0 +1,194 @@
+#include "bench/functions.hpp"
+#include "src/convopt.hpp"
+#include "src/lbfgs.hpp"
+#include "src/least_squares.hpp"
+#include "src/newton.hpp"
+#include "src/spaces.hpp"
+#include "src/trust_region.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+namespace {
+
+using opt::bench::quadratic;
+using opt::bench::quadratic_residuals;
+using opt::bench::rastrigin;
+using opt::bench::rosenbrock;
+using opt::bench::rosenbrock_residuals;
+
+template <class T, std::size_t N>
+using point = opt::point<T, N>;
+
+template <class F, class T, std::size_t N>
+void gradient(benchmark::State& state)
+{
+    const auto p = opt::bench::start_point<point<T, N>>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::gradient(p, F{}));
+    }
+}
+
+template <class F, class T, std::size_t N>
+void hessian(benchmark::State& state)
+{
+    const auto p = opt::bench::start_point<point<T, N>>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::hessian(p, F{}));
+    }
+}
+
+template <class F, class T, std::size_t N>
+void line_search(benchmark::State& state)
+{
+    const auto p = opt::bench::start_point<point<T, N>>();
+    const auto g = opt::gradient(p, F{});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::line_search(p, -g, F{}));
+    }
+}
+
+template <class F, class T, std::size_t N>
+void optimize(benchmark::State& state)
+{
+    const auto p = opt::bench::start_point<point<T, N>>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::optimize(p, F{}));
+    }
+}
+
+template <class F, class T, std::size_t N>
+void lbfgs(benchmark::State& state)
+{
+    const auto p = opt::bench::start_point<point<T, N>>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::lbfgs(p, F{}));
+    }
+}
+
+template <class F, class T, std::size_t N>
+void newton(benchmark::State& state)
+{
+    const auto p = opt::bench::start_point<point<T, N>>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::newton(p, F{}));
+    }
+}
+
+template <class F, class T, std::size_t N>
+void hessian_vector_product(benchmark::State& state)
+{
+    const auto p = opt::bench::start_point<point<T, N>>();
+    const auto v = opt::gradient(p, F{});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::hessian_vector_product(p, v, F{}));
+    }
+}
+
+template <class F, class T, std::size_t N>
+void newton_cg(benchmark::State& state)
+{
+    const auto p = opt::bench::start_point<point<T, N>>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::newton_cg(p, F{}));
+    }
+}
+
+// The workspace is reused by every solve, as in a loop over requests
+template <class F, class T, std::size_t N>
+void trust_region_dogleg(benchmark::State& state)
+{
+    const auto p = opt::bench::start_point<point<T, N>>();
+    auto w = opt::dogleg_workspace<point<T, N>>{};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::trust_region_dogleg(p, F{}, w));
+    }
+}
+
+template <class F, class T, std::size_t N>
+void trust_region_steihaug(benchmark::State& state)
+{
+    const auto p = opt::bench::start_point<point<T, N>>();
+    auto w = opt::steihaug_workspace{p};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::trust_region_steihaug(p, F{}, w));
+    }
+}
+
+// Least-squares solvers, on residuals of the functions above
+template <class F, class T, std::size_t N>
+void gauss_newton(benchmark::State& state)
+{
+    const auto p = opt::bench::start_point<point<T, N>>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::gauss_newton(p, F{}));
+    }
+}
+
+template <class F, class T, std::size_t N>
+void levenberg_marquardt(benchmark::State& state)
+{
+    const auto p = opt::bench::start_point<point<T, N>>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::levenberg_marquardt(p, F{}));
+    }
+}
+
+}  // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-owning-memory)
+#define OPT_ALGORITHM_BENCHMARK(fn, F)                                         \
+    BENCHMARK_TEMPLATE(fn, F, float, 2);                                       \
+    BENCHMARK_TEMPLATE(fn, F, float, 8);                                       \
+    BENCHMARK_TEMPLATE(fn, F, float, 32);                                      \
+    BENCHMARK_TEMPLATE(fn, F, double, 2);                                      \
+    BENCHMARK_TEMPLATE(fn, F, double, 8);                                      \
+    BENCHMARK_TEMPLATE(fn, F, double, 32)
+
+OPT_ALGORITHM_BENCHMARK(gradient, quadratic);
+OPT_ALGORITHM_BENCHMARK(gradient, rosenbrock);
+OPT_ALGORITHM_BENCHMARK(gradient, rastrigin);
+
+OPT_ALGORITHM_BENCHMARK(hessian, quadratic);
+OPT_ALGORITHM_BENCHMARK(hessian, rosenbrock);
+OPT_ALGORITHM_BENCHMARK(hessian, rastrigin);
+
+OPT_ALGORITHM_BENCHMARK(line_search, quadratic);
+OPT_ALGORITHM_BENCHMARK(line_search, rosenbrock);
+OPT_ALGORITHM_BENCHMARK(line_search, rastrigin);
+
+OPT_ALGORITHM_BENCHMARK(optimize, quadratic);
+OPT_ALGORITHM_BENCHMARK(optimize, rosenbrock);
+OPT_ALGORITHM_BENCHMARK(optimize, rastrigin);
+
+OPT_ALGORITHM_BENCHMARK(lbfgs, quadratic);
+OPT_ALGORITHM_BENCHMARK(lbfgs, rosenbrock);
+OPT_ALGORITHM_BENCHMARK(lbfgs, rastrigin);
+
+OPT_ALGORITHM_BENCHMARK(newton, quadratic);
+OPT_ALGORITHM_BENCHMARK(newton, rosenbrock);
+OPT_ALGORITHM_BENCHMARK(newton, rastrigin);
+
+OPT_ALGORITHM_BENCHMARK(hessian_vector_product, quadratic);
+OPT_ALGORITHM_BENCHMARK(hessian_vector_product, rosenbrock);
+OPT_ALGORITHM_BENCHMARK(hessian_vector_product, rastrigin);
+
+OPT_ALGORITHM_BENCHMARK(newton_cg, quadratic);
+OPT_ALGORITHM_BENCHMARK(newton_cg, rosenbrock);
+OPT_ALGORITHM_BENCHMARK(newton_cg, rastrigin);
+
+OPT_ALGORITHM_BENCHMARK(trust_region_dogleg, quadratic);
+OPT_ALGORITHM_BENCHMARK(trust_region_dogleg, rosenbrock);
+OPT_ALGORITHM_BENCHMARK(trust_region_dogleg, rastrigin);
+
+OPT_ALGORITHM_BENCHMARK(trust_region_steihaug, quadratic);
+OPT_ALGORITHM_BENCHMARK(trust_region_steihaug, rosenbrock);
+OPT_ALGORITHM_BENCHMARK(trust_region_steihaug, rastrigin);
+
+OPT_ALGORITHM_BENCHMARK(gauss_newton, quadratic_residuals);
+OPT_ALGORITHM_BENCHMARK(gauss_newton, rosenbrock_residuals);
+
+OPT_ALGORITHM_BENCHMARK(levenberg_marquardt, quadratic_residuals);
+OPT_ALGORITHM_BENCHMARK(levenberg_marquardt, rosenbrock_residuals);
+// NOLINTEND(cppcoreguidelines-owning-memory)
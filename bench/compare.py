@@ -0,0 +1,97 @@
+"""Flags benchmarks that regressed between two Google Benchmark JSON outputs.
+
+Produce the outputs with e.g.
+
+    bazel run -c opt //bench:algorithms -- \\
+        --benchmark_out=$PWD/new.json \\
+        --benchmark_out_format=json \\
+        --benchmark_repetitions=5
+
+and compare them with
+
+    bazel run //bench:compare -- $PWD/old.json $PWD/new.json
+
+When a file holds repetitions, the median of each benchmark is compared,
+otherwise the mean of its runs. Exits with status 1 if any benchmark is
+slower than the baseline by more than the threshold.
+"""
+
+import argparse
+import json
+import statistics
+import sys
+
+
+def load(path, metric):
+    """Maps each benchmark name in `path` to its time in nanoseconds."""
+    with open(path, encoding="utf-8") as f:
+        benchmarks = json.load(f)["benchmarks"]
+
+    scale = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+    medians = {}
+    runs = {}
+    for b in benchmarks:
+        time = b[metric] * scale[b.get("time_unit", "ns")]
+        if b.get("run_type") == "aggregate":
+            if b.get("aggregate_name") == "median":
+                medians[b["run_name"]] = time
+        elif "error_occurred" not in b:
+            runs.setdefault(b.get("run_name", b["name"]), []).append(time)
+
+    times = {name: statistics.mean(t) for name, t in runs.items()}
+    times.update(medians)
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline", help="JSON output of the old version")
+    parser.add_argument("contender", help="JSON output of the new version")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.05,
+        help="relative slowdown reported as a regression (default: 0.05)",
+    )
+    parser.add_argument(
+        "--metric",
+        choices=["real_time", "cpu_time"],
+        default="cpu_time",
+        help="time compared (default: cpu_time)",
+    )
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    contender = load(args.contender, args.metric)
+
+    width = max((len(name) for name in baseline | contender), default=0)
+    regressions = []
+    for name, old in baseline.items():
+        if name not in contender:
+            print(f"{name:<{width}}  missing")
+            continue
+        new = contender[name]
+        change = new / old - 1.0 if old > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            regressions.append(name)
+            flag = "  REGRESSION"
+        print(
+            f"{name:<{width}}  {old:12.1f} ns  {new:12.1f} ns  "
+            f"{change:+8.1%}{flag}"
+        )
+    for name in contender.keys() - baseline.keys():
+        print(f"{name:<{width}}  new")
+
+    if regressions:
+        print(
+            f"\n{len(regressions)} of {len(baseline)} benchmarks slower by more "
+            f"than {args.threshold:.0%}"
+        )
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
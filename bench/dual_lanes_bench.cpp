@@ -0,0 +1,126 @@
+#include "src/convopt.hpp"
+#include "src/math.hpp"
+#include "src/spaces.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+namespace {
+
+constexpr auto chained_cost = []<opt::Point P>(const P& x) {
+    using T = opt::scalar_t<P>;
+
+    auto acc = T{};
+    for (std::size_t i{0}; i < opt::dimension(x); ++i) {
+        const auto d = x[i] - T{1};
+        acc += d * d;
+    }
+    for (std::size_t i{0}; i + 1 < opt::dimension(x); ++i) {
+        acc += opt::sin(x[i] * x[i + 1]);
+    }
+    return acc;
+};
+
+// Evaluated on points of `dual`, an array of structures, one seeded
+// direction per evaluation
+constexpr auto aos_cost = []<opt::Point P>(const P& x)
+    requires(opt::Real<opt::scalar_t<P>> or opt::Dual<opt::scalar_t<P>>)
+{
+    return chained_cost(x);
+};
+
+// Evaluated on points of `dual_lanes`, with each infinitesimal component
+// stored contiguously across the seeded directions
+constexpr auto soa_cost = []<opt::Point P>(const P& x)
+    requires(not opt::HyperDualVec<opt::scalar_t<P>>)
+{
+    return chained_cost(x);
+};
+
+template <std::size_t N>
+auto make_point() -> opt::point<double, N>
+{
+    auto p = opt::point<double, N>{};
+    for (std::size_t i{0}; i < N; ++i) {
+        p[i] = 0.5 / static_cast<double>(i + 1);
+    }
+    return p;
+}
+
+auto make_dyn_point(std::size_t n) -> opt::dyn_point<double>
+{
+    auto p = opt::dyn_point<double>(n);
+    for (std::size_t i{0}; i < n; ++i) {
+        p[i] = 0.5 / static_cast<double>(i + 1);
+    }
+    return p;
+}
+
+template <std::size_t N>
+void hessian_aos(benchmark::State& state)
+{
+    const auto p = make_point<N>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::hessian(p, aos_cost));
+    }
+}
+
+template <std::size_t N>
+void hessian_soa(benchmark::State& state)
+{
+    const auto p = make_point<N>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::hessian(p, soa_cost));
+    }
+}
+
+template <std::size_t N>
+void hessian_rows(benchmark::State& state)
+{
+    const auto p = make_point<N>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::hessian(p, chained_cost));
+    }
+}
+
+void gradient_dynamic_aos(benchmark::State& state)
+{
+    const auto p = make_dyn_point(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::gradient(p, aos_cost));
+    }
+}
+
+void gradient_dynamic_soa(benchmark::State& state)
+{
+    const auto p = make_dyn_point(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::gradient(p, soa_cost));
+    }
+}
+
+}  // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-owning-memory)
+BENCHMARK_TEMPLATE(hessian_aos, 2);
+BENCHMARK_TEMPLATE(hessian_aos, 8);
+BENCHMARK_TEMPLATE(hessian_aos, 16);
+BENCHMARK_TEMPLATE(hessian_aos, 32);
+BENCHMARK_TEMPLATE(hessian_aos, 64);
+
+BENCHMARK_TEMPLATE(hessian_soa, 2);
+BENCHMARK_TEMPLATE(hessian_soa, 8);
+BENCHMARK_TEMPLATE(hessian_soa, 16);
+BENCHMARK_TEMPLATE(hessian_soa, 32);
+BENCHMARK_TEMPLATE(hessian_soa, 64);
+
+BENCHMARK_TEMPLATE(hessian_rows, 2);
+BENCHMARK_TEMPLATE(hessian_rows, 8);
+BENCHMARK_TEMPLATE(hessian_rows, 16);
+BENCHMARK_TEMPLATE(hessian_rows, 32);
+BENCHMARK_TEMPLATE(hessian_rows, 64);
+
+BENCHMARK(gradient_dynamic_aos)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK(gradient_dynamic_soa)->RangeMultiplier(4)->Range(4, 256);
+// NOLINTEND(cppcoreguidelines-owning-memory)
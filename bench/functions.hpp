@@ -0,0 +1,115 @@
+#pragma once
+
+#include "src/math.hpp"
+#include "src/spaces.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+
+/// Standard test functions of the benchmarks, defined for any dimension
+namespace opt::bench {
+
+/// Convex quadratic `sum (i + 1) x_i^2 / 2`, with a condition number equal
+/// to the dimension and its minimum at the origin
+struct quadratic {
+    template <Point P>
+    constexpr auto operator()(const P& x) const -> scalar_t<P>
+    {
+        using T = scalar_t<P>;
+
+        auto acc = T{};
+        for (std::size_t i{0}; i < dimension(x); ++i) {
+            acc += T{static_cast<float>(i + 1) / 2.0F} * x[i] * x[i];
+        }
+        return acc;
+    }
+};
+
+/// Rosenbrock function, with its minimum at `(1, ..., 1)` at the bottom of a
+/// narrow curved valley
+struct rosenbrock {
+    template <Point P>
+    constexpr auto operator()(const P& x) const -> scalar_t<P>
+    {
+        using T = scalar_t<P>;
+
+        auto acc = T{};
+        for (std::size_t i{0}; i + 1 < dimension(x); ++i) {
+            const auto a = x[i + 1] - x[i] * x[i];
+            const auto b = T{1} - x[i];
+            acc += T{100} * a * a + b * b;
+        }
+        return acc;
+    }
+};
+
+/// Rastrigin function, with a local minimum close to every integer point and
+/// its global minimum at the origin
+struct rastrigin {
+    template <Point P>
+    constexpr auto operator()(const P& x) const -> scalar_t<P>
+    {
+        using T = scalar_t<P>;
+
+        const auto two_pi = T{6.283185307179586F};
+
+        auto acc = T{};
+        for (std::size_t i{0}; i < dimension(x); ++i) {
+            acc += x[i] * x[i] + T{10} - T{10} * cos(two_pi * x[i]);
+        }
+        return acc;
+    }
+};
+
+/// Residuals of `quadratic`, half the sum of their squares being the same
+/// function
+struct quadratic_residuals {
+    template <Point P>
+        requires TupleSizable<P>
+    constexpr auto operator()(const P& x) const
+    {
+        using T = scalar_t<P>;
+
+        auto r = vector<T, std::tuple_size_v<P>>{};
+        for (std::size_t i{0}; i < dimension(x); ++i) {
+            r[i] = T{std::sqrt(static_cast<float>(i + 1))} * x[i];
+        }
+        return r;
+    }
+};
+
+/// Residuals of `rosenbrock`, half the sum of their squares being half the
+/// same function
+struct rosenbrock_residuals {
+    template <Point P>
+        requires TupleSizable<P>
+    constexpr auto operator()(const P& x) const
+    {
+        using T = scalar_t<P>;
+        constexpr auto N = std::tuple_size_v<P>;
+
+        auto r = vector<T, 2 * (N - 1)>{};
+        for (std::size_t i{0}; i + 1 < N; ++i) {
+            r[2 * i] = T{10} * (x[i + 1] - x[i] * x[i]);
+            r[2 * i + 1] = T{1} - x[i];
+        }
+        return r;
+    }
+};
+
+/// Starting point with coordinates in `[-1, 1]`, the same for each scalar
+/// type
+template <Point P>
+constexpr auto start_point() -> P
+{
+    using T = scalar_t<P>;
+
+    auto p = P{};
+    for (std::size_t i{0}; i < dimension(p); ++i) {
+        p[i] = T{static_cast<float>(i % 5) / 2.0F - 1.0F};
+    }
+    return p;
+}
+
+}  // namespace opt::bench
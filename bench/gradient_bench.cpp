@@ -0,0 +1,78 @@
+#include "src/convopt.hpp"
+#include "src/math.hpp"
+#include "src/spaces.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+namespace {
+
+constexpr auto chained_cost = []<opt::Point P>(const P& x) {
+    using T = opt::scalar_t<P>;
+    constexpr auto N = std::tuple_size_v<P>;
+
+    auto acc = T{};
+    for (std::size_t i{0}; i < N; ++i) {
+        const auto d = x[i] - T{1};
+        acc += d * d;
+    }
+    for (std::size_t i{0}; i + 1 < N; ++i) {
+        acc += opt::sin(x[i] * x[i + 1]);
+    }
+    return acc;
+};
+
+// Hides the single evaluation overload so that `opt::gradient` falls back to
+// one cost evaluation per coordinate
+constexpr auto per_coordinate_cost = []<opt::Point P>(const P& x)
+    requires(not opt::DualVec<opt::scalar_t<P>>)
+{
+    return chained_cost(x);
+};
+
+template <std::size_t N>
+auto make_point() -> opt::point<double, N>
+{
+    auto p = opt::point<double, N>{};
+    for (std::size_t i{0}; i < N; ++i) {
+        p[i] = 0.5 / static_cast<double>(i + 1);
+    }
+    return p;
+}
+
+template <std::size_t N>
+void gradient_per_coordinate(benchmark::State& state)
+{
+    const auto p = make_point<N>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::gradient(p, per_coordinate_cost));
+    }
+}
+
+template <std::size_t N>
+void gradient_single_pass(benchmark::State& state)
+{
+    const auto p = make_point<N>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::gradient(p, chained_cost));
+    }
+}
+
+}  // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-owning-memory)
+BENCHMARK_TEMPLATE(gradient_per_coordinate, 2);
+BENCHMARK_TEMPLATE(gradient_per_coordinate, 8);
+BENCHMARK_TEMPLATE(gradient_per_coordinate, 32);
+BENCHMARK_TEMPLATE(gradient_per_coordinate, 64);
+BENCHMARK_TEMPLATE(gradient_per_coordinate, 128);
+BENCHMARK_TEMPLATE(gradient_per_coordinate, 200);
+
+BENCHMARK_TEMPLATE(gradient_single_pass, 2);
+BENCHMARK_TEMPLATE(gradient_single_pass, 8);
+BENCHMARK_TEMPLATE(gradient_single_pass, 32);
+BENCHMARK_TEMPLATE(gradient_single_pass, 64);
+BENCHMARK_TEMPLATE(gradient_single_pass, 128);
+BENCHMARK_TEMPLATE(gradient_single_pass, 200);
+// NOLINTEND(cppcoreguidelines-owning-memory)
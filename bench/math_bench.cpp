@@ -0,0 +1,155 @@
+#include "src/math.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Each function is evaluated over `size` points spread evenly over its
+// domain
+constexpr std::size_t size{4096};
+
+namespace fn {
+
+struct exp {
+    static constexpr auto domain = std::pair{-80.0, 80.0};
+    static constexpr auto ours = opt::exp;
+    static constexpr auto reference = [](auto x) { return std::exp(x); };
+};
+struct log {
+    static constexpr auto domain = std::pair{1e-3, 1e3};
+    static constexpr auto ours = opt::log;
+    static constexpr auto reference = [](auto x) { return std::log(x); };
+};
+struct log1p {
+    static constexpr auto domain = std::pair{-0.5, 10.0};
+    static constexpr auto ours = opt::log1p;
+    static constexpr auto reference = [](auto x) { return std::log1p(x); };
+};
+struct sin {
+    static constexpr auto domain = std::pair{-100.0, 100.0};
+    static constexpr auto ours = opt::sin;
+    static constexpr auto reference = [](auto x) { return std::sin(x); };
+};
+struct cos {
+    static constexpr auto domain = std::pair{-100.0, 100.0};
+    static constexpr auto ours = opt::cos;
+    static constexpr auto reference = [](auto x) { return std::cos(x); };
+};
+struct tan {
+    static constexpr auto domain = std::pair{-100.0, 100.0};
+    static constexpr auto ours = opt::tan;
+    static constexpr auto reference = [](auto x) { return std::tan(x); };
+};
+struct tanh {
+    static constexpr auto domain = std::pair{-10.0, 10.0};
+    static constexpr auto ours = opt::tanh;
+    static constexpr auto reference = [](auto x) { return std::tanh(x); };
+};
+struct sqrt {
+    static constexpr auto domain = std::pair{0.0, 1e3};
+    static constexpr auto ours = opt::sqrt;
+    static constexpr auto reference = [](auto x) { return std::sqrt(x); };
+};
+/// `pow` with a fixed non integer exponent
+struct pow {
+    static constexpr auto domain = std::pair{1e-3, 1e3};
+    static constexpr auto ours = [](auto x) {
+        return opt::pow(x, decltype(x){1.7F});
+    };
+    static constexpr auto reference = [](auto x) {
+        return std::pow(x, decltype(x){1.7F});
+    };
+};
+
+}  // namespace fn
+
+template <class F, class T>
+auto inputs() -> std::vector<T>
+{
+    const auto [lo, hi] = F::domain;
+    auto x = std::vector<T>(size);
+    for (std::size_t i{0}; i < size; ++i) {
+        x[i] = static_cast<T>(lo + (hi - lo) * static_cast<double>(i) /
+                                       static_cast<double>(size - 1));
+    }
+    return x;
+}
+
+/// Distance between `x` and `expected` in units in the last place of
+/// `expected`
+template <class T>
+auto ulps(T x, T expected) -> double
+{
+    const auto a = std::abs(expected);
+    const auto ulp = std::nextafter(a, std::numeric_limits<T>::infinity()) - a;
+    return static_cast<double>(std::abs(x - expected) / ulp);
+}
+
+template <class F, class T>
+void ours(benchmark::State& state)
+{
+    const auto x = inputs<F, T>();
+    auto y = std::vector<T>(size);
+
+    for (auto _ : state) {
+        std::transform(x.begin(), x.end(), y.begin(), [](T xi) {
+            return F::ours(xi);
+        });
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+
+    auto max_ulps = 0.0;
+    for (std::size_t i{0}; i < size; ++i) {
+        max_ulps = std::max(max_ulps, ulps(y[i], F::reference(x[i])));
+    }
+    state.counters["max_ulps"] = max_ulps;
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<benchmark::IterationCount>(size));
+}
+
+template <class F, class T>
+void reference(benchmark::State& state)
+{
+    const auto x = inputs<F, T>();
+    auto y = std::vector<T>(size);
+
+    for (auto _ : state) {
+        std::transform(x.begin(), x.end(), y.begin(), [](T xi) {
+            return F::reference(xi);
+        });
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<benchmark::IterationCount>(size));
+}
+
+}  // namespace
+
+// `ours` reports its largest distance to <cmath> over the inputs as the
+// `max_ulps` counter
+// NOLINTBEGIN(cppcoreguidelines-owning-memory)
+#define OPT_MATH_BENCHMARK(F)                                                  \
+    BENCHMARK_TEMPLATE(ours, fn::F, float);                                    \
+    BENCHMARK_TEMPLATE(reference, fn::F, float);                               \
+    BENCHMARK_TEMPLATE(ours, fn::F, double);                                   \
+    BENCHMARK_TEMPLATE(reference, fn::F, double)
+
+OPT_MATH_BENCHMARK(exp);
+OPT_MATH_BENCHMARK(log);
+OPT_MATH_BENCHMARK(log1p);
+OPT_MATH_BENCHMARK(sin);
+OPT_MATH_BENCHMARK(cos);
+OPT_MATH_BENCHMARK(tan);
+OPT_MATH_BENCHMARK(tanh);
+OPT_MATH_BENCHMARK(sqrt);
+OPT_MATH_BENCHMARK(pow);
+// NOLINTEND(cppcoreguidelines-owning-memory)
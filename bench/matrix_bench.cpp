@@ -0,0 +1,85 @@
+#include "src/matrix.hpp"
+#include "src/spaces.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+
+namespace {
+
+template <class T, std::size_t N>
+using square = opt::matrix<opt::vector<T, N>, N>;
+
+template <class T, std::size_t N>
+auto make_matrix(T offset) -> std::unique_ptr<square<T, N>>
+{
+    auto m = std::make_unique<square<T, N>>();
+    for (std::size_t j{0}; j < N; ++j) {
+        for (std::size_t i{0}; i < N; ++i) {
+            (*m)[{i, j}] = offset + T{1} / static_cast<T>(i + 2 * j + 1);
+        }
+    }
+    return m;
+}
+
+template <std::size_t N>
+auto set_flops(benchmark::State& state) -> void
+{
+    state.counters["FLOP"] = benchmark::Counter(
+        2.0 * static_cast<double>(N * N * N),
+        benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Column by column with `matrix * vector`, the constexpr path
+template <class T, std::size_t N>
+void multiply_reference(benchmark::State& state)
+{
+    const auto a = make_matrix<T, N>(T{1});
+    const auto b = make_matrix<T, N>(T{2});
+    auto c = std::make_unique<square<T, N>>();
+    for (auto _ : state) {
+        std::transform(
+            b->begin(), b->end(), c->begin(), [&a](const auto& column) {
+                return *a * column;
+            });
+        benchmark::DoNotOptimize(c.get());
+        benchmark::ClobberMemory();
+    }
+    set_flops<N>(state);
+}
+
+template <class T, std::size_t N>
+void multiply(benchmark::State& state)
+{
+    const auto a = make_matrix<T, N>(T{1});
+    const auto b = make_matrix<T, N>(T{2});
+    auto c = std::make_unique<square<T, N>>();
+    for (auto _ : state) {
+        *c = *a * *b;
+        benchmark::DoNotOptimize(c.get());
+        benchmark::ClobberMemory();
+    }
+    set_flops<N>(state);
+}
+
+}  // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-owning-memory)
+#define OPT_MATRIX_BENCHMARK(fn, T)                                            \
+    BENCHMARK_TEMPLATE(fn, T, 2);                                              \
+    BENCHMARK_TEMPLATE(fn, T, 4);                                              \
+    BENCHMARK_TEMPLATE(fn, T, 8);                                              \
+    BENCHMARK_TEMPLATE(fn, T, 16);                                             \
+    BENCHMARK_TEMPLATE(fn, T, 32);                                             \
+    BENCHMARK_TEMPLATE(fn, T, 64);                                             \
+    BENCHMARK_TEMPLATE(fn, T, 128);                                            \
+    BENCHMARK_TEMPLATE(fn, T, 256);                                            \
+    BENCHMARK_TEMPLATE(fn, T, 512)
+
+OPT_MATRIX_BENCHMARK(multiply_reference, float);
+OPT_MATRIX_BENCHMARK(multiply_reference, double);
+OPT_MATRIX_BENCHMARK(multiply, float);
+OPT_MATRIX_BENCHMARK(multiply, double);
+// NOLINTEND(cppcoreguidelines-owning-memory)
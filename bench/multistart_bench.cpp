@@ -0,0 +1,51 @@
+#include "bench/functions.hpp"
+#include "src/multistart.hpp"
+#include "src/spaces.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <execution>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t dim = 8;
+
+auto make_starts(std::size_t n) -> std::vector<opt::point<double, dim>>
+{
+    auto starts = std::vector<opt::point<double, dim>>(n);
+    auto state = std::size_t{42};
+    for (auto& s : starts) {
+        for (std::size_t i{0}; i < dim; ++i) {
+            // Linear congruential generator, so that runs are reproducible
+            state = state * 6364136223846793005U + 1442695040888963407U;
+            s[i] = static_cast<double>(state >> 11U) * 0x1.0p-53 * 10.0 - 5.0;
+        }
+    }
+    return starts;
+}
+
+template <class E>
+void multistart(benchmark::State& state)
+{
+    const auto starts = make_starts(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            opt::multistart_optimize(starts, opt::bench::rastrigin{}, E{}));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-owning-memory)
+BENCHMARK_TEMPLATE(multistart, std::execution::sequenced_policy)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(multistart, std::execution::parallel_policy)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->UseRealTime();
+// NOLINTEND(cppcoreguidelines-owning-memory)
@@ -0,0 +1,65 @@
+#include "src/convopt.hpp"
+#include "src/math.hpp"
+#include "src/schedule.hpp"
+#include "src/spaces.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+namespace {
+
+// Evaluated once per coordinate, on points of `dual`, with a cost linear in
+// the dimension
+constexpr auto chained_cost = []<opt::Point P>(const P& x)
+    requires(opt::Real<opt::scalar_t<P>> or opt::Dual<opt::scalar_t<P>>)
+{
+    using T = opt::scalar_t<P>;
+
+    auto acc = T{};
+    for (std::size_t i{0}; i < opt::dimension(x); ++i) {
+        const auto d = x[i] - T{1};
+        acc += d * d;
+    }
+    for (std::size_t i{0}; i + 1 < opt::dimension(x); ++i) {
+        acc += opt::sin(x[i] * x[i + 1]);
+    }
+    return acc;
+};
+
+auto make_point(std::size_t n) -> opt::dyn_point<double>
+{
+    auto p = opt::dyn_point<double>(n);
+    for (std::size_t i{0}; i < n; ++i) {
+        p[i] = 0.5 / static_cast<double>(i + 1);
+    }
+    return p;
+}
+
+template <class S>
+void gradient(benchmark::State& state)
+{
+    const auto p = make_point(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::gradient(p, chained_cost, S{}));
+    }
+}
+
+}  // namespace
+
+// The crossover between serial and parallel is where the cost of all
+// evaluations exceeds the cost of starting the parallel tasks
+// NOLINTBEGIN(cppcoreguidelines-owning-memory)
+BENCHMARK_TEMPLATE(gradient, opt::serial)
+    ->RangeMultiplier(2)
+    ->Range(2, 512)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(gradient, opt::parallel)
+    ->RangeMultiplier(2)
+    ->Range(2, 512)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(gradient, opt::adaptive)
+    ->RangeMultiplier(2)
+    ->Range(2, 512)
+    ->UseRealTime();
+// NOLINTEND(cppcoreguidelines-owning-memory)
@@ -0,0 +1,186 @@
+#include "src/expression.hpp"
+#include "src/spaces.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace {
+
+template <class T>
+constexpr auto factor = static_cast<T>(0.3);
+
+template <class T>
+auto make_vector(std::size_t n, T offset) -> opt::dyn_vector<T>
+{
+    auto v = opt::dyn_vector<T>(n);
+    for (std::size_t i{0}; i < n; ++i) {
+        v[i] = offset + T{1} / static_cast<T>(i + 1);
+    }
+    return v;
+}
+
+template <class T>
+auto set_processed(benchmark::State& state, std::size_t arrays) -> void
+{
+    const auto n = state.range(0);
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * n *
+                            static_cast<std::int64_t>(arrays * sizeof(T)));
+}
+
+// Scalar loops, as written before the vectorized kernels
+
+template <class T>
+void add_reference(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto x = make_vector<T>(n, T{1});
+    const auto y = make_vector<T>(n, T{2});
+    auto r = opt::dyn_vector<T>(n);
+    for (auto _ : state) {
+        std::transform(x.data.cbegin(),
+                       x.data.cend(),
+                       y.data.cbegin(),
+                       r.data.begin(),
+                       std::plus<>{});
+        benchmark::DoNotOptimize(r.data.data());
+        benchmark::ClobberMemory();
+    }
+    set_processed<T>(state, 3);
+}
+
+template <class T>
+void axpy_reference(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto x = make_vector<T>(n, T{1});
+    const auto y = make_vector<T>(n, T{2});
+    auto r = opt::dyn_vector<T>(n);
+    for (auto _ : state) {
+        std::transform(x.data.cbegin(),
+                       x.data.cend(),
+                       y.data.cbegin(),
+                       r.data.begin(),
+                       [](T a, T b) { return a + factor<T> * b; });
+        benchmark::DoNotOptimize(r.data.data());
+        benchmark::ClobberMemory();
+    }
+    set_processed<T>(state, 3);
+}
+
+template <class T>
+void dot_reference(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto x = make_vector<T>(n, T{1});
+    const auto y = make_vector<T>(n, T{2});
+    for (auto _ : state) {
+        auto r = T{};
+        for (std::size_t i{0}; i < n; ++i) {
+            r += x[i] * y[i];
+        }
+        benchmark::DoNotOptimize(r);
+    }
+    set_processed<T>(state, 2);
+}
+
+// Library operations
+
+template <class T>
+void add(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto x = make_vector<T>(n, T{1});
+    const auto y = make_vector<T>(n, T{2});
+    auto r = opt::dyn_vector<T>(n);
+    for (auto _ : state) {
+        opt::assign(r, opt::lazy(x) + opt::lazy(y));
+        benchmark::DoNotOptimize(r.data.data());
+        benchmark::ClobberMemory();
+    }
+    set_processed<T>(state, 3);
+}
+
+template <class T>
+void add_eager(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto x = make_vector<T>(n, T{1});
+    const auto y = make_vector<T>(n, T{2});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x + y);
+    }
+    set_processed<T>(state, 3);
+}
+
+template <class T>
+void scale_eager(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto x = make_vector<T>(n, T{1});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(factor<T> * x);
+    }
+    set_processed<T>(state, 2);
+}
+
+template <class T>
+void axpy(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto x = make_vector<T>(n, T{1});
+    const auto y = make_vector<T>(n, T{2});
+    auto r = opt::dyn_vector<T>(n);
+    for (auto _ : state) {
+        opt::assign(r, opt::lazy(x) + factor<T> * opt::lazy(y));
+        benchmark::DoNotOptimize(r.data.data());
+        benchmark::ClobberMemory();
+    }
+    set_processed<T>(state, 3);
+}
+
+template <class T>
+void dot(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto x = make_vector<T>(n, T{1});
+    const auto y = make_vector<T>(n, T{2});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::dot(x, y));
+    }
+    set_processed<T>(state, 2);
+}
+
+template <class T>
+void norm(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto x = make_vector<T>(n, T{1});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::norm(x));
+    }
+    set_processed<T>(state, 1);
+}
+
+}  // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-owning-memory)
+#define OPT_SPACES_BENCHMARK(fn)                                               \
+    BENCHMARK_TEMPLATE(fn, float)->RangeMultiplier(16)->Range(4, 1 << 20);     \
+    BENCHMARK_TEMPLATE(fn, double)->RangeMultiplier(16)->Range(4, 1 << 20)
+
+OPT_SPACES_BENCHMARK(add_reference);
+OPT_SPACES_BENCHMARK(axpy_reference);
+OPT_SPACES_BENCHMARK(dot_reference);
+
+OPT_SPACES_BENCHMARK(add);
+OPT_SPACES_BENCHMARK(add_eager);
+OPT_SPACES_BENCHMARK(scale_eager);
+OPT_SPACES_BENCHMARK(axpy);
+OPT_SPACES_BENCHMARK(dot);
+OPT_SPACES_BENCHMARK(norm);
+// NOLINTEND(cppcoreguidelines-owning-memory)
@@ -0,0 +1,94 @@
+#include "src/schedule.hpp"
+#include "src/spaces.hpp"
+#include "src/sparse_matrix.hpp"
+#include "src/sparse_matrix_ops.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// 2D Laplacian on a `side`x`side` grid, shifted to be positive definite
+auto laplacian(std::size_t side) -> opt::csr_matrix<double>
+{
+    const auto n = side * side;
+
+    auto entries = std::vector<std::pair<std::size_t, std::size_t>>{};
+    for (std::size_t i{0}; i < n; ++i) {
+        entries.emplace_back(i, i);
+        if (i % side + 1 < side) {
+            entries.emplace_back(i, i + 1);
+            entries.emplace_back(i + 1, i);
+        }
+        if (i + side < n) {
+            entries.emplace_back(i, i + side);
+            entries.emplace_back(i + side, i);
+        }
+    }
+
+    auto m = opt::csr_matrix<double>{
+        opt::sparsity_pattern::from_entries(n, n, std::move(entries))};
+    m.values.resize(m.nonzeros());
+    for (std::size_t i{0}; i < n; ++i) {
+        for (auto k = m.pattern.offsets[i]; k < m.pattern.offsets[i + 1];
+             ++k) {
+            m.values[k] = m.pattern.indices[k] == i ? 4.1 : -1.0;
+        }
+    }
+    return m;
+}
+
+auto side(const benchmark::State& state) -> std::size_t
+{
+    return static_cast<std::size_t>(state.range(0));
+}
+
+void analyze(benchmark::State& state)
+{
+    const auto a = laplacian(side(state));
+    for (auto _ : state) {
+        auto s = opt::analyze_cholesky(a.pattern);
+        benchmark::DoNotOptimize(s.factor.indices.data());
+    }
+    state.counters["nnz(L)"] = static_cast<double>(
+        opt::analyze_cholesky(a.pattern).factor.nonzeros());
+}
+
+// Numeric factorization only, the symbolic one being reused
+void factorize(benchmark::State& state)
+{
+    const auto a = laplacian(side(state));
+    auto f = opt::sparse_cholesky<double>{opt::analyze_cholesky(a.pattern)};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt::cholesky(a, f));
+        benchmark::ClobberMemory();
+    }
+}
+
+template <class S>
+void multiply(benchmark::State& state)
+{
+    const auto a = laplacian(side(state));
+    const auto x = opt::dyn_vector<double>(a.cols(), 1.0);
+    for (auto _ : state) {
+        auto y = opt::multiply(a, x, S{});
+        benchmark::DoNotOptimize(y.data.data());
+    }
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<benchmark::IterationCount>(
+                                a.nonzeros()));
+}
+
+}  // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-owning-memory)
+BENCHMARK(analyze)->RangeMultiplier(4)->Range(16, 256);
+BENCHMARK(factorize)->RangeMultiplier(4)->Range(16, 256);
+BENCHMARK_TEMPLATE(multiply, opt::serial)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK_TEMPLATE(multiply, opt::adaptive)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024);
+// NOLINTEND(cppcoreguidelines-owning-memory)
@@ -2,6 +2,7 @@
 
 #include <concepts>
 #include <cstddef>
+#include <span>
 #include <type_traits>
 #include <utility>
 
@@ -86,6 +87,23 @@ concept TupleSizable =
     { std::tuple_size<T>::value  } -> std::same_as<const std::size_t&>;
   };
 
+template <class T>
+concept DynamicSizable =
+  (not TupleSizable<T>) &&
+  requires (const T& a) {
+    { a.size() } -> std::same_as<std::size_t>;
+  };
+
+template <class T>
+concept Sizable = TupleSizable<T> || DynamicSizable<T>;
+
+/// Number of coordinates known at compile time, `std::dynamic_extent`
+/// otherwise
+template <class T>
+inline constexpr std::size_t extent_v = std::dynamic_extent;
+template <TupleSizable T>
+inline constexpr std::size_t extent_v<T> = std::tuple_size<T>::value;
+
 template <Indexable T>
 using scalar_t = std::remove_cvref_t<decltype(std::declval<T&>()[0])>;
 
@@ -93,7 +111,7 @@ template <class T, class U = scalar_t<T>>
 concept Vector =
   Arithmetic<U> &&
   std::regular<T> &&
-  TupleSizable<T> &&
+  Sizable<T> &&
   Indexable<T> &&
   Addable<T> &&
   Subtractible<T> &&
@@ -112,8 +130,8 @@ template <class T, class U = distance_t<T>>
 concept Point =
   Vector<U> &&
   std::regular<T> &&
-  TupleSizable<T> &&
-  (std::tuple_size<T>::value == std::tuple_size<U>::value) &&
+  Sizable<T> &&
+  (extent_v<T> == extent_v<U>) &&
   Indexable<T> &&
   Addable<const T&, const U&, T> &&
   Addable<const U&, const T&, T> &&
@@ -126,7 +144,34 @@ struct point;
 namespace impl {
 template <Arithmetic>
 struct dual;
-}
+template <Arithmetic, std::size_t>
+struct dual_vec;
+template <Arithmetic, std::size_t>
+struct hyper_dual_vec;
+template <Arithmetic, std::size_t>
+struct dual_lanes;
+template <Arithmetic>
+struct adjoint;
+template <Arithmetic, std::size_t>
+struct taylor;
+template <Arithmetic>
+struct sparsity_tracer;
+
+/// Number of directions seeded together in a single cost evaluation, enough
+/// to fill 64 bytes of lanes
+template <class T>
+inline constexpr std::size_t lane_width_v =
+    sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+}  // namespace impl
+
+/// Point type with the same dimension as `P` and scalar type `S`
+template <class P, class S>
+struct rebind_point {
+    using type = opt::point<S, extent_v<P>>;
+};
+
+template <class P, class S>
+using rebind_point_t = typename rebind_point<P, S>::type;
 
 // TODO replace total ordering requirement with partial ordering
 template <class T, class P>
@@ -134,9 +179,66 @@ concept Cost =
   Point<P> &&
   std::regular_invocable<const T&, const P&> &&
   std::regular_invocable<const T&,
-                         const opt::point<impl::dual<scalar_t<P>>, std::tuple_size<P>::value>&> &&
+                         const rebind_point_t<P, impl::dual<scalar_t<P>>>&> &&
   std::totally_ordered<std::invoke_result_t<const T&, const P&>>;
 
+template <class T, class P>
+concept VectorCost =
+  Cost<T, P> &&
+  TupleSizable<P> &&
+  std::regular_invocable<const T&,
+                         const rebind_point_t<P, impl::dual_vec<scalar_t<P>, extent_v<P>>>&>;
+
+template <class T, class P>
+concept HyperVectorCost =
+  Cost<T, P> &&
+  TupleSizable<P> &&
+  std::regular_invocable<const T&,
+                         const rebind_point_t<P, impl::hyper_dual_vec<scalar_t<P>, extent_v<P>>>&>;
+
+template <class T, class P>
+concept LaneCost =
+  Cost<T, P> &&
+  std::regular_invocable<const T&,
+                         const rebind_point_t<P, impl::dual_vec<scalar_t<P>, impl::lane_width_v<scalar_t<P>>>>&> &&
+  std::regular_invocable<const T&,
+                         const rebind_point_t<P, impl::dual_lanes<scalar_t<P>, impl::lane_width_v<scalar_t<P>>>>&>;
+
+/// Cost that can also evaluate many points per call, as
+/// `cost(points, results)` with `std::span<const Q> points` and
+/// `std::span<R> results` of the same size, for plain and dual points
+///
+/// Batches of dual points compute gradients and Hessians, batches of plain
+/// points the values at the starts of `multistart_optimize`.
+template <class T, class P>
+concept BatchCost =
+  Cost<T, P> &&
+  std::invocable<const T&,
+                 std::span<const P>,
+                 std::span<scalar_t<P>>> &&
+  std::invocable<const T&,
+                 std::span<const rebind_point_t<P, impl::dual<scalar_t<P>>>>,
+                 std::span<impl::dual<scalar_t<P>>>>;
+
+/// Function returning a vector of residuals of fixed size, for plain and
+/// dual points
+template <class T, class P>
+concept Residuals =
+  Point<P> &&
+  TupleSizable<P> &&
+  std::regular_invocable<const T&, const P&> &&
+  std::regular_invocable<const T&,
+                         const rebind_point_t<P, impl::dual<scalar_t<P>>>&> &&
+  Vector<std::invoke_result_t<const T&, const P&>> &&
+  TupleSizable<std::invoke_result_t<const T&, const P&>> &&
+  std::same_as<scalar_t<std::invoke_result_t<const T&, const P&>>, scalar_t<P>>;
+
+template <class T, class P>
+concept VectorResiduals =
+  Residuals<T, P> &&
+  std::regular_invocable<const T&,
+                         const rebind_point_t<P, impl::dual_vec<scalar_t<P>, extent_v<P>>>&>;
+
 // clang-format on
 
 }  // namespace opt
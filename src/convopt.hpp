@@ -2,43 +2,94 @@
 
 #include "src/concepts.hpp"
 #include "src/dualnumbers.hpp"
+#include "src/expression.hpp"
+#include "src/line_search.hpp"
+#include "src/matrix.hpp"
+#include "src/observer.hpp"
+#include "src/reverse.hpp"
+#include "src/schedule.hpp"
+#include "src/solver_options.hpp"
 #include "src/spaces.hpp"
+#include "src/stdx/cmath.hpp"
+#include "src/taylor.hpp"
 
 #include <algorithm>
 #include <array>
-#include <execution>
+#include <concepts>
+#include <functional>
 #include <iostream>
+#include <span>
+#include <tuple>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace opt {
 namespace detail {
 
-template <std::size_t N, class R = std::array<std::size_t, N>>
-[[nodiscard]] consteval auto index_array() -> R
+/// Row and column indices of the upper triangle of an `N`x`N` matrix
+template <std::size_t N,
+          class R = std::array<std::pair<std::size_t, std::size_t>,
+                               N*(N + 1) / 2>>
+[[nodiscard]] consteval auto upper_triangle_index_array() -> R
 {
     auto is = R{};
 
-    for (auto n : std::views::iota(std::size_t{}, N)) {
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-        is[n] = n;
+    auto n = std::size_t{};
+    for (auto i : std::views::iota(std::size_t{}, N)) {
+        for (auto j = i; j < N; ++j) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            is[n++] = {i, j};
+        }
     }
 
     return is;
 }
 
-template <Point P,
-          class R = opt::point<dual<scalar_t<P>>, std::tuple_size_v<P>>>
+template <Point P, class R = rebind_point_t<P, dual<scalar_t<P>>>>
 [[nodiscard]] constexpr auto as_point_dual(const P& p) -> R
 {
     if constexpr (std::is_same_v<P, R>) {
         return p;
     }
 
+    const auto n = dimension(p);
+    auto to = make_zero<R>(n);
+
+    for (auto i : std::views::iota(std::size_t{}, n)) {
+        to[i].real = p[i];
+    }
+
+    return to;
+}
+
+template <Point P,
+          class R = rebind_point_t<P, dual_vec<scalar_t<P>, extent_v<P>>>>
+[[nodiscard]] constexpr auto as_point_dual_vec(const P& p) -> R
+{
     constexpr auto N = std::tuple_size_v<P>;
     auto to = R{};
 
     for (auto i : std::views::iota(std::size_t{}, N)) {
         to[i].real = p[i];
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        to[i].eps[i] = 1;
+    }
+
+    return to;
+}
+
+template <Point P,
+          class R = rebind_point_t<P, hyper_dual_vec<scalar_t<P>, extent_v<P>>>>
+[[nodiscard]] constexpr auto as_point_hyper_dual_vec(const P& p) -> R
+{
+    constexpr auto N = std::tuple_size_v<P>;
+    auto to = R{};
+
+    for (auto j : std::views::iota(std::size_t{}, N)) {
+        to[j].real = p[j];
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        to[j].e2[j] = 1;
     }
 
     return to;
@@ -46,106 +97,824 @@ template <Point P,
 
 }  // namespace detail
 
-template <Point P, Cost<P> F>
-constexpr auto gradient(const P& p, F cost) -> distance_t<P>
+/// Computes the gradient of `cost` at `p`, one cost evaluation per
+/// coordinate
+///
+/// The evaluations are run by the scheduler `s`.
+template <Point P, Cost<P> F, Scheduler S = adaptive>
+constexpr auto gradient(const P& p, F cost, S s = {}) -> distance_t<P>
+{
+    const auto n = dimension(p);
+
+    auto r = detail::make_zero<distance_t<P>>(n);
+    auto set_range = [&r, &cost, d = detail::as_point_dual(p)](
+                         std::size_t first, std::size_t last) {
+        auto di = d;
+        for (auto i = first; i < last; ++i) {
+            di[i].e1 = 1;
+            r[i] = cost(di).e1;
+            di[i].e1 = 0;
+        }
+    };
+
+    detail::schedule(s, n, set_range);
+    return r;
+}
+
+/// Computes the gradient with a single evaluation of `cost`, seeding one
+/// infinitesimal component per coordinate
+template <Point P, VectorCost<P> F, Scheduler S = adaptive>
+constexpr auto gradient(const P& p, F cost, [[maybe_unused]] S s = {})
+    -> distance_t<P>
 {
     constexpr auto N = std::tuple_size_v<P>;
 
+    const auto c = cost(detail::as_point_dual_vec(p));
+
     auto r = distance_t<P>{};
-    auto set_ith = [&r, &cost, d = detail::as_point_dual(p)](auto i) {
-        auto di = d;
-        di[i].e1 = 1;
-        r[i] = cost(di).e1;
+    for (auto i : std::views::iota(std::size_t{}, N)) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        r[i] = c.eps[i];
+    }
+    return r;
+}
+
+/// Computes the gradient seeding one coordinate per lane, so that `W`
+/// coordinates are propagated by each evaluation of `cost`
+///
+/// Used when `cost` can't be evaluated on a `dual_vec` with one component per
+/// coordinate, e.g. when the dimension is only known at runtime.
+template <Point P, LaneCost<P> F, Scheduler S = adaptive>
+    requires(not VectorCost<F, P>) && (not BatchCost<F, P>)
+constexpr auto gradient(const P& p, F cost, S s = {}) -> distance_t<P>
+{
+    using T = scalar_t<P>;
+    constexpr auto W = impl::lane_width_v<T>;
+    const auto n = dimension(p);
+
+    using D = rebind_point_t<P, dual_vec<T, W>>;
+
+    auto r = detail::make_zero<distance_t<P>>(n);
+    auto set_blocks = [&r, &cost, n, d = detail::as_point_dual<P, D>(p)](
+                          std::size_t first_block, std::size_t last_block) {
+        auto db = d;
+        for (auto b = first_block; b < last_block; ++b) {
+            const auto first = b * W;
+            const auto last = std::min(first + W, n);
+
+            for (auto i = first; i < last; ++i) {
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+                db[i].eps[i - first] = 1;
+            }
+            const auto c = cost(db);
+            for (auto i = first; i < last; ++i) {
+                // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+                r[i] = c.eps[i - first];
+                db[i].eps[i - first] = 0;
+                // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+            }
+        }
+    };
+
+    detail::schedule(s, (n + W - 1) / W, set_blocks);
+    return r;
+}
+
+namespace detail {
+
+/// Largest number of points passed to a `BatchCost` in a single call
+inline constexpr std::size_t max_batch_size = 64;
+
+/// Evaluates `cost` on copies of the dual point of `p`, the `k`-th for `k`
+/// in `[first, last)` seeded with `seed(k, point, 1)`, and passes each
+/// result to `read(k, result)`
+///
+/// Points are passed in batches of at most `max_batch_size`. A seed is
+/// cleared with `seed(k, point, 0)`, so the buffer is reused without copying
+/// `p` again.
+template <Point P, class F, class Seed, class Read>
+constexpr auto evaluate_batches(const P& p,
+                                const F& cost,
+                                std::size_t first,
+                                std::size_t last,
+                                const Seed& seed,
+                                const Read& read) -> void
+{
+    using T = scalar_t<P>;
+    using D = rebind_point_t<P, dual<T>>;
+
+    auto points = std::vector<D>(std::min(last - first, max_batch_size),
+                                 as_point_dual(p));
+    auto results = std::vector<dual<T>>(points.size());
+
+    for (auto b = first; b < last; b += max_batch_size) {
+        const auto m = std::min(max_batch_size, last - b);
+        for (std::size_t k{0}; k < m; ++k) {
+            seed(b + k, points[k], T{1});
+        }
+        cost(std::span<const D>{points.data(), m},
+             std::span<dual<T>>{results.data(), m});
+        for (std::size_t k{0}; k < m; ++k) {
+            read(b + k, results[k]);
+            seed(b + k, points[k], T{});
+        }
+    }
+}
+
+/// Computes the cost and gradient of `cost` at `p`, one batch of points per
+/// range of coordinates handed out by `s`
+///
+/// The value is the real part of any of the evaluations.
+template <Point P, BatchCost<P> F, Scheduler S>
+constexpr auto batch_value_and_gradient(const P& p, const F& cost, const S& s)
+    -> std::pair<scalar_t<P>, distance_t<P>>
+{
+    using T = scalar_t<P>;
+    const auto n = dimension(p);
+
+    auto value = T{};
+    auto r = make_zero<distance_t<P>>(n);
+    auto set_range = [&value, &r, &cost, &p](std::size_t first,
+                                             std::size_t last) {
+        evaluate_batches(
+            p,
+            cost,
+            first,
+            last,
+            [](std::size_t i, auto& di, T seed) { di[i].e1 = seed; },
+            [&value, &r](std::size_t i, const dual<T>& c) {
+                if (i == 0) {
+                    value = c.real;
+                }
+                r[i] = c.e1;
+            });
     };
 
-    constexpr auto idx = detail::index_array<N>();
-#ifdef __cpp_lib_execution
-    if (not std::is_constant_evaluated()) {
-        std::for_each(
-            std::execution::par_unseq,
-            idx.cbegin(),
-            idx.cend(),
-            std::move(set_ith));
-        return r;
-    }
-#endif
-    std::for_each(idx.cbegin(), idx.cend(), std::move(set_ith));
+    schedule(s, n, set_range);
+    return {value, std::move(r)};
+}
+
+}  // namespace detail
+
+/// Computes the gradient passing the points seeded for a range of
+/// coordinates to `cost` in a single call
+///
+/// Preferred over one evaluation per coordinate or per block of lanes, a
+/// batch lets `cost` vectorize across points and share work between them.
+template <Point P, BatchCost<P> F, Scheduler S = adaptive>
+    requires(not VectorCost<F, P>)
+constexpr auto gradient(const P& p, F cost, S s = {}) -> distance_t<P>
+{
+    return detail::batch_value_and_gradient(p, cost, s).second;
+}
+
+/// Computes the gradient with `gradient(p, cost, s)`, sending a
+/// `phase_event` to `observer`
+template <Point P, Cost<P> F, Scheduler S, class O>
+constexpr auto gradient(const P& p, F cost, S s, O observer) -> distance_t<P>
+{
+    return detail::timed(
+        observer, phase::gradient, [&p, &cost, &s] {
+            return gradient(p, cost, s);
+        });
+}
+
+/// Computes the gradient in reverse mode, recording one evaluation of `cost`
+/// on `t`
+///
+/// The tape is cleared first and keeps its memory, so reusing it across
+/// iterations does not allocate once it has grown to the size of `cost`.
+template <Point P, Cost<P> F>
+    requires std::regular_invocable<const F&,
+                                    const rebind_point_t<P, adjoint<scalar_t<P>>>&>
+auto gradient_reverse(const P& p, F cost, tape<scalar_t<P>>& t)
+    -> distance_t<P>
+{
+    const auto n = dimension(p);
+
+    t.clear();
+    auto x = detail::make_zero<rebind_point_t<P, adjoint<scalar_t<P>>>>(n);
+    for (auto i : std::views::iota(std::size_t{}, n)) {
+        x[i] = {p[i], t, t.variable()};
+    }
+
+    const auto y = cost(x);
+
+    auto r = detail::make_zero<distance_t<P>>(n);
+    if (y.recorder == &t) {
+        t.backward(y.index);
+        for (auto i : std::views::iota(std::size_t{}, n)) {
+            r[i] = t.adjoint(x[i].index);
+        }
+    }
     return r;
 }
 
+/// Computes the gradient in reverse mode on a tape local to the calling
+/// thread
 template <Point P, Cost<P> F>
-constexpr auto hessian(const P& p, F cost)
+    requires std::regular_invocable<const F&,
+                                    const rebind_point_t<P, adjoint<scalar_t<P>>>&>
+auto gradient_reverse(const P& p, F cost) -> distance_t<P>
 {
-    constexpr auto N = std::tuple_size_v<P>;
+    thread_local auto t = tape<scalar_t<P>>{};
+    return gradient_reverse(p, std::move(cost), t);
+}
 
-    auto h = std::array<distance_t<P>, N>{};
-    auto set_ijth = [&h, &cost, d = detail::as_point_dual(p)](auto ij) {
-        const auto i = ij / N;
-        const auto j = ij % N;
+/// Computes the Hessian of `cost` at `p`
+///
+/// Only the upper triangle is evaluated, one cost evaluation per entry, and
+/// mirrored into the lower triangle.
+template <Point P, Cost<P> F, Scheduler S = adaptive>
+    requires TupleSizable<P>
+constexpr auto hessian(const P& p, F cost, S s = {})
+    -> matrix<distance_t<P>, std::tuple_size_v<P>>
+{
+    constexpr auto N = std::tuple_size_v<P>;
+    constexpr auto ij = detail::upper_triangle_index_array<N>();
 
+    auto h = matrix<distance_t<P>, N>{};
+    auto set_range = [&h, &cost, &ij, d = detail::as_point_dual(p)](
+                         std::size_t first, std::size_t last) {
         auto dij = d;
-        dij[i].e1 = 1;
-        dij[j].e2 = 1;
-        // FIXME(enrlov): properly index matrices when available
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-        h[i][j] = cost(dij).e3;
+        for (auto k = first; k < last; ++k) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            const auto [i, j] = ij[k];
+
+            dij[i].e1 = 1;
+            dij[j].e2 = 1;
+            h[{i, j}] = cost(dij).e3;
+            h[{j, i}] = h[{i, j}];
+            dij[i].e1 = 0;
+            dij[j].e2 = 0;
+        }
     };
 
-    constexpr auto ij = detail::index_array<N * N>();
-#ifdef __cpp_lib_execution
-    if (not std::is_constant_evaluated()) {
-        std::for_each(
-            std::execution::par_unseq,
-            ij.cbegin(),
-            ij.cend(),
-            std::move(set_ijth));
-        return h;
-    }
-#endif
-    std::for_each(ij.cbegin(), ij.cend(), std::move(set_ijth));
+    detail::schedule(s, ij.size(), set_range);
     return h;
 }
 
-template <Point P, Cost<P> F>
-constexpr auto line_search(P orig, distance_t<P> direction, F cost) -> P
+/// Computes the Hessian of `cost` at `p`, evaluating `W` entries of the
+/// upper triangle per cost evaluation
+///
+/// Each lane of `dual_lanes` seeds a different pair of coordinates, entries
+/// below the diagonal are mirrored.
+template <Point P, LaneCost<P> F, Scheduler S = adaptive>
+    requires TupleSizable<P> && (not HyperVectorCost<F, P>) &&
+             (not BatchCost<F, P>)
+constexpr auto hessian(const P& p, F cost, S s = {})
+    -> matrix<distance_t<P>, std::tuple_size_v<P>>
+{
+    using T = scalar_t<P>;
+    constexpr auto N = std::tuple_size_v<P>;
+    constexpr auto W = impl::lane_width_v<T>;
+    constexpr auto ij = detail::upper_triangle_index_array<N>();
+    using D = rebind_point_t<P, dual_lanes<T, W>>;
+
+    auto h = matrix<distance_t<P>, N>{};
+    auto set_blocks = [&h, &cost, &ij, d = detail::as_point_dual<P, D>(p)](
+                          std::size_t first_block, std::size_t last_block) {
+        auto db = d;
+        for (auto b = first_block; b < last_block; ++b) {
+            const auto first = b * W;
+            const auto last = std::min(first + W, ij.size());
+
+            for (auto k = first; k < last; ++k) {
+                // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+                const auto [i, j] = ij[k];
+                db[i].e1[k - first] = 1;
+                db[j].e2[k - first] = 1;
+                // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+            }
+            const auto c = cost(db);
+            for (auto k = first; k < last; ++k) {
+                // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+                const auto [i, j] = ij[k];
+                h[{i, j}] = c.e3[k - first];
+                h[{j, i}] = h[{i, j}];
+                db[i].e1[k - first] = 0;
+                db[j].e2[k - first] = 0;
+                // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+            }
+        }
+    };
+
+    detail::schedule(s, (ij.size() + W - 1) / W, set_blocks);
+    return h;
+}
+
+/// Computes the Hessian of `cost` at `p`, passing the points seeded for a
+/// range of entries of the upper triangle to `cost` in a single call
+template <Point P, BatchCost<P> F, Scheduler S = adaptive>
+    requires TupleSizable<P> && (not HyperVectorCost<F, P>)
+constexpr auto hessian(const P& p, F cost, S s = {})
+    -> matrix<distance_t<P>, std::tuple_size_v<P>>
+{
+    using T = scalar_t<P>;
+    constexpr auto N = std::tuple_size_v<P>;
+    constexpr auto ij = detail::upper_triangle_index_array<N>();
+
+    auto h = matrix<distance_t<P>, N>{};
+    auto set_range = [&h, &cost, &ij, &p](std::size_t first,
+                                          std::size_t last) {
+        detail::evaluate_batches(
+            p,
+            cost,
+            first,
+            last,
+            [&ij](std::size_t k, auto& dk, T seed) {
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+                const auto [i, j] = ij[k];
+                dk[i].e1 = seed;
+                dk[j].e2 = seed;
+            },
+            [&h, &ij](std::size_t k, const dual<T>& c) {
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+                const auto [i, j] = ij[k];
+                h[{i, j}] = c.e3;
+                h[{j, i}] = c.e3;
+            });
+    };
+
+    detail::schedule(s, ij.size(), set_range);
+    return h;
+}
+
+/// Computes the Hessian of `cost` at `p`, one row per cost evaluation
+///
+/// Entries below the diagonal are mirrored from the upper triangle so that
+/// the result is exactly symmetric.
+template <Point P, HyperVectorCost<P> F, Scheduler S = adaptive>
+constexpr auto hessian(const P& p, F cost, S s = {})
+    -> matrix<distance_t<P>, std::tuple_size_v<P>>
+{
+    constexpr auto N = std::tuple_size_v<P>;
+
+    auto h = matrix<distance_t<P>, N>{};
+    auto set_rows = [&h, &cost, d = detail::as_point_hyper_dual_vec(p)](
+                        std::size_t first, std::size_t last) {
+        auto di = d;
+        for (auto i = first; i < last; ++i) {
+            di[i].e1 = 1;
+            const auto row = cost(di).e3;
+            di[i].e1 = 0;
+
+            for (auto j = i; j < N; ++j) {
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+                h[{i, j}] = row[j];
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+                h[{j, i}] = row[j];
+            }
+        }
+    };
+
+    detail::schedule(s, N, set_rows);
+    return h;
+}
+
+/// Computes the Hessian with `hessian(p, cost, s)`, sending a `phase_event`
+/// to `observer`
+template <Point P, Cost<P> F, Scheduler S, class O>
+    requires TupleSizable<P>
+constexpr auto hessian(const P& p, F cost, S s, O observer)
+    -> matrix<distance_t<P>, std::tuple_size_v<P>>
+{
+    return detail::timed(observer, phase::hessian, [&p, &cost, &s] {
+        return hessian(p, cost, s);
+    });
+}
+
+/// Computes the product of the Hessian of `cost` at `p` with `v`, one cost
+/// evaluation per coordinate, without forming the Hessian
+///
+/// Every evaluation seeds `e1` with `v` and `e2` with a coordinate, whose
+/// entry of the product is then `e3`. Points of dynamic size are supported.
+/// The evaluations are run by the scheduler `s`.
+template <Point P, Cost<P> F, Scheduler S = adaptive>
+constexpr auto hessian_vector_product(const P& p,
+                                      const distance_t<P>& v,
+                                      F cost,
+                                      S s = {}) -> distance_t<P>
+{
+    const auto n = dimension(p);
+
+    auto d = detail::as_point_dual(p);
+    for (std::size_t i{0}; i < n; ++i) {
+        d[i].e1 = v[i];
+    }
+
+    auto r = detail::make_zero<distance_t<P>>(n);
+    auto set_range = [&r, &cost, &d](std::size_t first, std::size_t last) {
+        auto di = d;
+        for (auto i = first; i < last; ++i) {
+            di[i].e2 = 1;
+            r[i] = cost(di).e3;
+            di[i].e2 = 0;
+        }
+    };
+
+    detail::schedule(s, n, set_range);
+    return r;
+}
+
+/// Computes the product of the Hessian of `cost` at `p` with `v`, `W`
+/// entries per cost evaluation
+///
+/// Each lane of `dual_lanes` seeds `e2` with a different coordinate, all of
+/// them seeding `e1` with `v`.
+template <Point P, LaneCost<P> F, Scheduler S = adaptive>
+    requires(not HyperVectorCost<F, P>)
+constexpr auto hessian_vector_product(const P& p,
+                                      const distance_t<P>& v,
+                                      F cost,
+                                      S s = {}) -> distance_t<P>
 {
-    // TODO(enrlov): Implement actual linesearch
-    // FIXME don't assume scalar type is constructible from float
-    constexpr scalar_t<P> lambda{0.001F};  // NOLINT(readability-magic-numbers)
+    using T = scalar_t<P>;
+    constexpr auto W = impl::lane_width_v<T>;
+    const auto n = dimension(p);
+
+    using D = rebind_point_t<P, dual_lanes<T, W>>;
 
-    while (true) {
-        auto end = orig + lambda * direction;
+    auto d = detail::as_point_dual<P, D>(p);
+    for (std::size_t i{0}; i < n; ++i) {
+        d[i].e1.fill(v[i]);
+    }
 
-        if (cost(end) >= cost(orig)) {
-            return orig;
+    auto r = detail::make_zero<distance_t<P>>(n);
+    auto set_blocks = [&r, &cost, n, &d](std::size_t first_block,
+                                         std::size_t last_block) {
+        auto db = d;
+        for (auto b = first_block; b < last_block; ++b) {
+            const auto first = b * W;
+            const auto last = std::min(first + W, n);
+
+            for (auto i = first; i < last; ++i) {
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+                db[i].e2[i - first] = 1;
+            }
+            const auto c = cost(db);
+            for (auto i = first; i < last; ++i) {
+                // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+                r[i] = c.e3[i - first];
+                db[i].e2[i - first] = 0;
+                // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+            }
         }
+    };
+
+    detail::schedule(s, (n + W - 1) / W, set_blocks);
+    return r;
+}
+
+/// Computes the product of the Hessian of `cost` at `p` with `v` with a
+/// single evaluation of `cost`, seeding `e1` with `v` and one component of
+/// `e2` per coordinate
+template <Point P, HyperVectorCost<P> F, Scheduler S = adaptive>
+constexpr auto hessian_vector_product(const P& p,
+                                      const distance_t<P>& v,
+                                      F cost,
+                                      [[maybe_unused]] S s = {})
+    -> distance_t<P>
+{
+    constexpr auto N = std::tuple_size_v<P>;
 
-        std::exchange(orig, std::move(end));
+    auto d = detail::as_point_hyper_dual_vec(p);
+    for (std::size_t i{0}; i < N; ++i) {
+        d[i].e1 = v[i];
     }
+    const auto c = cost(d);
+
+    auto r = distance_t<P>{};
+    for (std::size_t i{0}; i < N; ++i) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        r[i] = c.e3[i];
+    }
+    return r;
 }
 
-template <Vector V>
-constexpr auto stopping_criterion(const V& g) -> bool
+/// Computes the derivatives of order 0 to `K` of `t -> cost(p + t direction)`
+/// at `t = 0`, with a single evaluation of `cost` on `taylor` numbers
+///
+/// Element 2 is the curvature `direction^T H direction` and element 3 the
+/// third order term used by Halley-type steps.
+template <std::size_t K, Point P, class F>
+    requires std::regular_invocable<
+        const F&,
+        const rebind_point_t<P, taylor<scalar_t<P>, K>>&>
+constexpr auto directional_derivatives(const P& p,
+                                       F cost,
+                                       const distance_t<P>& direction)
+    -> std::array<scalar_t<P>, K + 1>
 {
-    // FIXME don't assume scalar type is constructible from float
-    constexpr scalar_t<V> tol{0.0001F};  // NOLINT(readability-magic-numbers)
+    using T = taylor<scalar_t<P>, K>;
 
-    return opt::norm(g) < tol;
+    const auto n = dimension(p);
+    auto q = detail::make_zero<rebind_point_t<P, T>>(n);
+    for (std::size_t i{0}; i < n; ++i) {
+        q[i] = T::variable(p[i], direction[i]);
+    }
+
+    const auto y = T{cost(q)};
+    auto r = std::array<scalar_t<P>, K + 1>{};
+    for (std::size_t k{0}; k <= K; ++k) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        r[k] = y.derivative(k);
+    }
+    return r;
 }
 
-template <Point P, Cost<P> F>
-constexpr auto optimize(P x, F c) -> P
+/// Restriction of `cost` to the line through `x` along `direction`
+///
+/// The cost and gradient at the last trial step are cached, so a line search
+/// policy may query the same step again without evaluating `cost`. Each
+/// evaluation of the gradient sends a `phase_event` to `observer`.
+template <Point P, Cost<P> F, class O = no_observer>
+class line_function {
+  public:
+    using scalar_type = scalar_t<P>;
+    using sample_type = line_sample<scalar_type>;
+
+  private:
+    const P* x_;
+    const distance_t<P>* direction_;
+    const F* cost_;
+    O observer_;
+    sample_type origin_;
+
+    scalar_type alpha_{};
+    P point_;
+    scalar_type value_{};
+    distance_t<P> gradient_;
+    bool has_value_{false};
+    bool has_gradient_{false};
+
+    std::size_t cost_evaluations_{};
+    std::size_t gradient_evaluations_{};
+
+    constexpr auto move_to(scalar_type alpha) -> void
+    {
+        if (alpha != alpha_) {
+            alpha_ = alpha;
+            assign(point_, lazy(*x_) + alpha * lazy(*direction_));
+            has_value_ = false;
+            has_gradient_ = false;
+        }
+    }
+
+  public:
+    /// `value` and `g` are the cost and its gradient at `x`
+    constexpr line_function(const P& x,
+                            const distance_t<P>& direction,
+                            const F& cost,
+                            scalar_type value,
+                            const distance_t<P>& g,
+                            O observer = {})
+        : x_{&x},
+          direction_{&direction},
+          cost_{&cost},
+          observer_{std::move(observer)},
+          origin_{scalar_type{}, value, dot(g, direction)},
+          point_{x},
+          value_{value},
+          gradient_{g},
+          has_value_{true},
+          has_gradient_{true}
+    {}
+
+    [[nodiscard]] constexpr auto origin() const -> sample_type
+    {
+        return origin_;
+    }
+
+    /// Cost at `x + alpha * direction`
+    constexpr auto value(scalar_type alpha) -> scalar_type
+    {
+        move_to(alpha);
+        if (not has_value_) {
+            value_ = (*cost_)(point_);
+            has_value_ = true;
+            ++cost_evaluations_;
+        }
+        return value_;
+    }
+
+    /// Gradient at `x + alpha * direction`
+    constexpr auto gradient(scalar_type alpha) -> const distance_t<P>&
+    {
+        move_to(alpha);
+        if (not has_gradient_) {
+            gradient_ = detail::timed(observer_, phase::gradient, [this] {
+                return opt::gradient(point_, *cost_);
+            });
+            has_gradient_ = true;
+            ++gradient_evaluations_;
+        }
+        return gradient_;
+    }
+
+    /// Cost and directional derivative at `x + alpha * direction`
+    constexpr auto sample(scalar_type alpha) -> sample_type
+    {
+        if constexpr (BatchCost<F, P> and not VectorCost<F, P>) {
+            move_to(alpha);
+            if (not has_value_ and not has_gradient_) {
+                // The batch for the gradient also yields the value
+                std::tie(value_, gradient_) =
+                    detail::timed(observer_, phase::gradient, [this] {
+                        return detail::batch_value_and_gradient(
+                            point_, *cost_, adaptive{});
+                    });
+                has_value_ = true;
+                has_gradient_ = true;
+                ++gradient_evaluations_;
+            }
+        }
+        const auto v = value(alpha);
+        return {alpha, v, dot(gradient(alpha), *direction_)};
+    }
+
+    /// The point `x + alpha * direction`
+    constexpr auto point(scalar_type alpha) -> const P&
+    {
+        move_to(alpha);
+        return point_;
+    }
+
+    [[nodiscard]] constexpr auto cost_evaluations() const -> std::size_t
+    {
+        return cost_evaluations_;
+    }
+    [[nodiscard]] constexpr auto gradient_evaluations() const -> std::size_t
+    {
+        return gradient_evaluations_;
+    }
+};
+
+/// Point reached by a line search, with the cost and gradient there
+template <Point P>
+struct line_search_result {
+    P x;
+    scalar_t<P> alpha{};
+    scalar_t<P> value{};
+    distance_t<P> gradient;
+
+    std::size_t cost_evaluations{};
+    std::size_t gradient_evaluations{};
+};
+
+/// Searches a step along `direction` from `x`, where `cost` has value
+/// `value` and gradient `g`
+///
+/// Returns `x` itself, with a zero step, if `search` finds no step decreasing
+/// the cost. Sends a `phase_event` with the evaluation counts to `observer`,
+/// after those of the gradients evaluated during the search.
+template <Point P,
+          Cost<P> F,
+          class S = more_thuente,
+          class O = no_observer>
+    requires LineSearch<S, line_function<P, F>>
+constexpr auto line_search(const P& x,
+                           const distance_t<P>& direction,
+                           F cost,
+                           scalar_t<P> value,
+                           const distance_t<P>& g,
+                           S search = {},
+                           O observer = {}) -> line_search_result<P>
+{
+    const auto run = [&]() -> line_search_result<P> {
+        auto phi = line_function<P, F, decltype(std::ref(observer))>{
+            x, direction, cost, value, g, std::ref(observer)};
+
+        const auto alpha = search(phi, scalar_t<P>{1});
+        if (not(alpha > scalar_t<P>{})) {
+            return {x,
+                    scalar_t<P>{},
+                    value,
+                    g,
+                    phi.cost_evaluations(),
+                    phi.gradient_evaluations()};
+        }
+
+        const auto v = phi.value(alpha);
+        const auto& gradient = phi.gradient(alpha);
+        return {phi.point(alpha),
+                alpha,
+                v,
+                gradient,
+                phi.cost_evaluations(),
+                phi.gradient_evaluations()};
+    };
+
+    return detail::timed(
+        observer,
+        phase::line_search,
+        run,
+        [](phase_event& e, const line_search_result<P>& r) {
+            e.cost_evaluations = r.cost_evaluations;
+            e.gradient_evaluations = r.gradient_evaluations;
+        });
+}
+
+/// Searches a step along `direction` from `x`
+///
+/// The evaluations at `x` are included in the counts.
+template <Point P,
+          Cost<P> F,
+          class S = more_thuente,
+          class O = no_observer>
+    requires LineSearch<S, line_function<P, F>>
+constexpr auto line_search(const P& x,
+                           const distance_t<P>& direction,
+                           F cost,
+                           S search = {},
+                           O observer = {}) -> line_search_result<P>
+{
+    const auto value = cost(x);
+    auto r = line_search(x,
+                         direction,
+                         cost,
+                         value,
+                         gradient(x, cost, adaptive{}, std::ref(observer)),
+                         std::move(search),
+                         std::ref(observer));
+    ++r.cost_evaluations;
+    ++r.gradient_evaluations;
+    return r;
+}
+
+/// Minimizes `c` by steepest descent from `x`, choosing each step with the
+/// line search policy `S`, until one of the criteria of `options` is met
+///
+/// Sends an `iteration_event` to `observer` at `x` and after each step, and
+/// the events of the gradients and line searches. Stops early if `observer`
+/// returns `control::stop` from an iteration event.
+template <class S = more_thuente, Point P, Cost<P> F, class O = no_observer>
+    requires LineSearch<S, line_function<P, F>>
+constexpr auto optimize(P x,
+                        F c,
+                        solver_options<scalar_t<P>> options = {},
+                        O observer = {}) -> solve_result<P>
 {
-    auto g{gradient(x, c)};
+    using T = scalar_t<P>;
+
+    const auto stop = detail::stop_criteria{options};
 
-    constexpr std::size_t max_steps{10};
-    for (std::size_t steps{0U}; not stopping_criterion(g) and steps < max_steps;
-         ++steps) {
-        x = line_search(std::move(x), -g, c);
-        g = gradient(x, c);
+    auto r = solve_result<P>{};
+    r.value = c(x);
+    r.gradient = gradient(x, c, adaptive{}, std::ref(observer));
+    r.x = std::move(x);
+    r.cost_evaluations = 1;
+    r.gradient_evaluations = 1;
+
+    const auto notify_iteration = [&r, &observer]([[maybe_unused]] T step) {
+        if constexpr (std::invocable<O&, const iteration_event<P>&>) {
+            return detail::notify(
+                observer,
+                iteration_event<P>{r.iterations,
+                                   r.x,
+                                   r.value,
+                                   stdx::sqrt(norm(r.gradient)),
+                                   step,
+                                   r.cost_evaluations,
+                                   r.gradient_evaluations});
+        } else {
+            return control::proceed;
+        }
+    };
+
+    auto decrease = T{};
+    auto step_length = T{};
+    auto alpha = T{};
+    for (;;) {
+        if (notify_iteration(alpha) == control::stop) {
+            r.reason = stop_reason::observer;
+            break;
+        }
+        if (const auto reason = stop(r, decrease, step_length)) {
+            r.reason = *reason;
+            break;
+        }
+
+        auto step = line_search(
+            r.x, -r.gradient, c, r.value, r.gradient, S{}, std::ref(observer));
+        r.cost_evaluations += step.cost_evaluations;
+        r.gradient_evaluations += step.gradient_evaluations;
+        if (not(step.alpha > T{})) {
+            r.reason = stop_reason::line_search_failed;
+            break;
+        }
+
+        alpha = step.alpha;
+        decrease = r.value - step.value;
+        step_length = alpha * stdx::sqrt(norm(r.gradient));
+
+        r.x = std::move(step.x);
+        r.value = step.value;
+        r.gradient = std::move(step.gradient);
+        ++r.iterations;
     }
 
-    return x;
+    return r;
 }
 
 }  // namespace opt
@@ -3,7 +3,10 @@
 #include "concepts.hpp"
 #include "stdx/traits.hpp"
 
+#include <array>
+#include <cstddef>
 #include <iostream>
+#include <type_traits>
 
 namespace opt {
 namespace impl {
@@ -110,9 +113,399 @@ dual(T) -> dual<T>;
 template <class T>
 dual(T, T, T, T) -> dual<T>;
 #endif
+
+/// First order dual number with `N` infinitesimal components
+///
+/// Seeding component `i` of coordinate `i` propagates the whole gradient
+/// through a single evaluation.
+template <Arithmetic T, std::size_t N>
+struct dual_vec {
+    using eps_type = std::array<T, N>;
+
+    T real{};
+    eps_type eps{};
+
+  private:
+    template <class F>
+    [[nodiscard]] static constexpr auto
+    transform(const eps_type& x, const eps_type& y, F f) -> eps_type
+    {
+        auto r = eps_type{};
+        for (std::size_t i{0}; i < N; ++i) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            r[i] = f(x[i], y[i]);
+        }
+        return r;
+    }
+
+  public:
+    [[nodiscard]] friend constexpr auto
+    operator+(const dual_vec& x, const dual_vec& y) -> dual_vec
+    {
+        return {x.real + y.real,
+                transform(x.eps, y.eps, [](T a, T b) { return a + b; })};
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator-(const dual_vec& x, const dual_vec& y) -> dual_vec
+    {
+        return {x.real - y.real,
+                transform(x.eps, y.eps, [](T a, T b) { return a - b; })};
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator*(const dual_vec& x, const dual_vec& y) -> dual_vec
+    {
+        return {x.real * y.real,
+                transform(x.eps, y.eps, [&x, &y](T a, T b) {
+                    return x.real * b + a * y.real;
+                })};
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator/(const dual_vec& x, const dual_vec& y) -> dual_vec
+    {
+        const auto den{y.real * y.real};
+        return {x.real / y.real,
+                transform(x.eps, y.eps, [&x, &y, &den](T a, T b) {
+                    return (a * y.real - x.real * b) / den;
+                })};
+    }
+
+    constexpr auto operator+=(const dual_vec& x) -> dual_vec&
+    {
+        return *this = *this + x;
+    }
+    constexpr auto operator-=(const dual_vec& x) -> dual_vec&
+    {
+        return *this = *this - x;
+    }
+    constexpr auto operator*=(const dual_vec& x) -> dual_vec&
+    {
+        return *this = *this * x;
+    }
+    constexpr auto operator/=(const dual_vec& x) -> dual_vec&
+    {
+        return *this = *this / x;
+    }
+
+    friend auto operator<<(std::ostream& os, const dual_vec& x)
+        -> std::ostream&
+    {
+        os << "(" << x.real;
+        for (const auto& e : x.eps) {
+            os << ", " << e;
+        }
+        os << ")";
+        return os;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator<(const dual_vec& x, const dual_vec& y) -> bool
+    {
+        return x.real < y.real;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator==(const dual_vec& x, const dual_vec& y) -> bool = default;
+
+    [[nodiscard]] friend constexpr auto operator-(const dual_vec& x)
+        -> dual_vec
+    {
+        return {-x.real, transform(x.eps, x.eps, [](T a, T) { return -a; })};
+    }
+
+    [[nodiscard]] friend constexpr auto
+    close_to(const dual_vec& x, const dual_vec& y, const T& tol) -> bool
+    {
+        constexpr auto abs = [](auto x) {
+            if (x < decltype(x){}) {
+                return -x;
+            }
+
+            return x;
+        };
+
+        if (not(abs(x.real - y.real) < tol)) {
+            return false;
+        }
+        for (std::size_t i{0}; i < N; ++i) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            if (not(abs(x.eps[i] - y.eps[i]) < tol)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/// Second order dual number with a vector of `N` components along `e2`
+///
+/// Seeding `e1` on coordinate `i` and `e2[j]` on every coordinate `j`
+/// propagates the `i`-th row of the Hessian into `e3` in a single
+/// evaluation.
+template <Arithmetic T, std::size_t N>
+struct hyper_dual_vec {
+    using eps_type = std::array<T, N>;
+
+    T real{};
+    T e1{};
+    eps_type e2{};
+    eps_type e3{};
+
+    [[nodiscard]] friend constexpr auto
+    operator+(const hyper_dual_vec& x, const hyper_dual_vec& y)
+        -> hyper_dual_vec
+    {
+        auto r = hyper_dual_vec{x.real + y.real, x.e1 + y.e1};
+        for (std::size_t j{0}; j < N; ++j) {
+            // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+            r.e2[j] = x.e2[j] + y.e2[j];
+            r.e3[j] = x.e3[j] + y.e3[j];
+            // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator-(const hyper_dual_vec& x, const hyper_dual_vec& y)
+        -> hyper_dual_vec
+    {
+        auto r = hyper_dual_vec{x.real - y.real, x.e1 - y.e1};
+        for (std::size_t j{0}; j < N; ++j) {
+            // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+            r.e2[j] = x.e2[j] - y.e2[j];
+            r.e3[j] = x.e3[j] - y.e3[j];
+            // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator*(const hyper_dual_vec& x, const hyper_dual_vec& y)
+        -> hyper_dual_vec
+    {
+        auto r = hyper_dual_vec{x.real * y.real,
+                                x.real * y.e1 + x.e1 * y.real};
+        for (std::size_t j{0}; j < N; ++j) {
+            // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+            r.e2[j] = x.real * y.e2[j] + x.e2[j] * y.real;
+            r.e3[j] = x.real * y.e3[j] + x.e3[j] * y.real + x.e1 * y.e2[j] +
+                      x.e2[j] * y.e1;
+            // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator/(const hyper_dual_vec& x, const hyper_dual_vec& y)
+        -> hyper_dual_vec
+    {
+        const auto den{y.real * y.real};
+        auto r = hyper_dual_vec{x.real / y.real,
+                                (x.e1 * y.real - x.real * y.e1) / den};
+        for (std::size_t j{0}; j < N; ++j) {
+            // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+            r.e2[j] = (x.e2[j] * y.real - x.real * y.e2[j]) / den;
+            r.e3[j] = ((2 * y.e1 * y.e2[j] - y.e3[j]) * x.real / y.real +
+                       x.e3[j] * y.real - x.e1 * y.e2[j] - x.e2[j] * y.e1) /
+                      den;
+            // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        return r;
+    }
+
+    constexpr auto operator+=(const hyper_dual_vec& x) -> hyper_dual_vec&
+    {
+        return *this = *this + x;
+    }
+    constexpr auto operator-=(const hyper_dual_vec& x) -> hyper_dual_vec&
+    {
+        return *this = *this - x;
+    }
+    constexpr auto operator*=(const hyper_dual_vec& x) -> hyper_dual_vec&
+    {
+        return *this = *this * x;
+    }
+    constexpr auto operator/=(const hyper_dual_vec& x) -> hyper_dual_vec&
+    {
+        return *this = *this / x;
+    }
+
+    friend auto operator<<(std::ostream& os, const hyper_dual_vec& x)
+        -> std::ostream&
+    {
+        os << "(" << x.real << ", " << x.e1;
+        for (std::size_t j{0}; j < N; ++j) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            os << ", [" << x.e2[j] << ", " << x.e3[j] << "]";
+        }
+        os << ")";
+        return os;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator<(const hyper_dual_vec& x, const hyper_dual_vec& y) -> bool
+    {
+        return x.real < y.real;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator==(const hyper_dual_vec& x, const hyper_dual_vec& y)
+        -> bool = default;
+
+    [[nodiscard]] friend constexpr auto operator-(const hyper_dual_vec& x)
+        -> hyper_dual_vec
+    {
+        auto r = hyper_dual_vec{-x.real, -x.e1};
+        for (std::size_t j{0}; j < N; ++j) {
+            // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+            r.e2[j] = -x.e2[j];
+            r.e3[j] = -x.e3[j];
+            // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        return r;
+    }
+};
+
+/// `W` second order dual numbers sharing the same real part
+///
+/// Each infinitesimal component is stored contiguously across the `W`
+/// lanes, so seeding a different direction in each lane propagates `W`
+/// derivatives through a single evaluation and every operation is a loop
+/// over contiguous lanes. Lane `k` is computed exactly as a `dual` with the
+/// components `e1[k]`, `e2[k]` and `e3[k]`.
+template <Arithmetic T, std::size_t W>
+struct dual_lanes {
+    using lanes_type = std::array<T, W>;
+
+    static constexpr auto width = W;
+
+    T real{};
+    lanes_type e1{};
+    lanes_type e2{};
+    lanes_type e3{};
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+
+    [[nodiscard]] friend constexpr auto
+    operator+(const dual_lanes& x, const dual_lanes& y) -> dual_lanes
+    {
+        auto r = dual_lanes{x.real + y.real};
+        for (std::size_t k{0}; k < W; ++k) {
+            r.e1[k] = x.e1[k] + y.e1[k];
+            r.e2[k] = x.e2[k] + y.e2[k];
+            r.e3[k] = x.e3[k] + y.e3[k];
+        }
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator-(const dual_lanes& x, const dual_lanes& y) -> dual_lanes
+    {
+        auto r = dual_lanes{x.real - y.real};
+        for (std::size_t k{0}; k < W; ++k) {
+            r.e1[k] = x.e1[k] - y.e1[k];
+            r.e2[k] = x.e2[k] - y.e2[k];
+            r.e3[k] = x.e3[k] - y.e3[k];
+        }
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator*(const dual_lanes& x, const dual_lanes& y) -> dual_lanes
+    {
+        auto r = dual_lanes{x.real * y.real};
+        for (std::size_t k{0}; k < W; ++k) {
+            r.e1[k] = x.real * y.e1[k] + x.e1[k] * y.real;
+            r.e2[k] = x.real * y.e2[k] + x.e2[k] * y.real;
+            r.e3[k] = x.real * y.e3[k] + x.e3[k] * y.real +
+                      x.e1[k] * y.e2[k] + x.e2[k] * y.e1[k];
+        }
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator/(const dual_lanes& x, const dual_lanes& y) -> dual_lanes
+    {
+        const auto den{y.real * y.real};
+        auto r = dual_lanes{x.real / y.real};
+        for (std::size_t k{0}; k < W; ++k) {
+            r.e1[k] = (x.e1[k] * y.real - x.real * y.e1[k]) / den;
+            r.e2[k] = (x.e2[k] * y.real - x.real * y.e2[k]) / den;
+            r.e3[k] = ((2 * y.e1[k] * y.e2[k] - y.e3[k]) * x.real / y.real +
+                       x.e3[k] * y.real - x.e1[k] * y.e2[k] -
+                       x.e2[k] * y.e1[k]) /
+                      den;
+        }
+        return r;
+    }
+
+    constexpr auto operator+=(const dual_lanes& x) -> dual_lanes&
+    {
+        return *this = *this + x;
+    }
+    constexpr auto operator-=(const dual_lanes& x) -> dual_lanes&
+    {
+        return *this = *this - x;
+    }
+    constexpr auto operator*=(const dual_lanes& x) -> dual_lanes&
+    {
+        return *this = *this * x;
+    }
+    constexpr auto operator/=(const dual_lanes& x) -> dual_lanes&
+    {
+        return *this = *this / x;
+    }
+
+    friend auto operator<<(std::ostream& os, const dual_lanes& x)
+        -> std::ostream&
+    {
+        os << "(" << x.real;
+        for (std::size_t k{0}; k < W; ++k) {
+            os << ", [" << x.e1[k] << ", " << x.e2[k] << ", " << x.e3[k]
+               << "]";
+        }
+        os << ")";
+        return os;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator<(const dual_lanes& x, const dual_lanes& y) -> bool
+    {
+        return x.real < y.real;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator==(const dual_lanes& x, const dual_lanes& y) -> bool = default;
+
+    [[nodiscard]] friend constexpr auto operator-(const dual_lanes& x)
+        -> dual_lanes
+    {
+        auto r = dual_lanes{-x.real};
+        for (std::size_t k{0}; k < W; ++k) {
+            r.e1[k] = -x.e1[k];
+            r.e2[k] = -x.e2[k];
+            r.e3[k] = -x.e3[k];
+        }
+        return r;
+    }
+
+    /// The `dual` number held in lane `k`
+    [[nodiscard]] constexpr auto lane(std::size_t k) const -> dual<T>
+    {
+        return {real, e1[k], e2[k], e3[k]};
+    }
+
+    // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+};
+
 }  // namespace impl
 
 using impl::dual;
+using impl::dual_vec;
+using impl::hyper_dual_vec;
+using impl::dual_lanes;
 
 template <class T>
 using is_dual = stdx::is_specialization_of<T, dual>;
@@ -124,7 +517,71 @@ template <class T>
 concept Dual = is_dual_v<T>;
 
 template <class T>
-concept Real = Arithmetic<T> && not
-Dual<T>;
+struct is_dual_vec : std::false_type {};
+template <class T, std::size_t N>
+struct is_dual_vec<dual_vec<T, N>> : std::true_type {};
+
+template <class T>
+inline constexpr bool is_dual_vec_v = is_dual_vec<T>::value;
+
+template <class T>
+concept DualVec = is_dual_vec_v<T>;
+
+template <class T>
+struct is_hyper_dual_vec : std::false_type {};
+template <class T, std::size_t N>
+struct is_hyper_dual_vec<hyper_dual_vec<T, N>> : std::true_type {};
+
+template <class T>
+inline constexpr bool is_hyper_dual_vec_v = is_hyper_dual_vec<T>::value;
+
+template <class T>
+concept HyperDualVec = is_hyper_dual_vec_v<T>;
+
+template <class T>
+struct is_dual_lanes : std::false_type {};
+template <class T, std::size_t W>
+struct is_dual_lanes<dual_lanes<T, W>> : std::true_type {};
+
+template <class T>
+inline constexpr bool is_dual_lanes_v = is_dual_lanes<T>::value;
+
+template <class T>
+concept DualLanes = is_dual_lanes_v<T>;
+
+template <class T>
+using is_adjoint = stdx::is_specialization_of<T, impl::adjoint>;
+
+template <class T>
+inline constexpr bool is_adjoint_v = is_adjoint<T>::value;
+
+template <class T>
+concept Adjoint = is_adjoint_v<T>;
+
+template <class T>
+struct is_taylor : std::false_type {};
+template <class T, std::size_t K>
+struct is_taylor<impl::taylor<T, K>> : std::true_type {};
+
+template <class T>
+inline constexpr bool is_taylor_v = is_taylor<T>::value;
+
+template <class T>
+concept Taylor = is_taylor_v<T>;
+
+template <class T>
+using is_sparsity_tracer =
+    stdx::is_specialization_of<T, impl::sparsity_tracer>;
+
+template <class T>
+inline constexpr bool is_sparsity_tracer_v = is_sparsity_tracer<T>::value;
+
+template <class T>
+concept SparsityTracer = is_sparsity_tracer_v<T>;
+
+template <class T>
+concept Real = Arithmetic<T> && not Dual<T> && not DualVec<T> &&
+               not HyperDualVec<T> && not DualLanes<T> && not Adjoint<T> &&
+               not Taylor<T> && not SparsityTracer<T>;
 
 }  // namespace opt
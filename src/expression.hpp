@@ -0,0 +1,235 @@
+#pragma once
+
+#include "concepts.hpp"
+#include "spaces.hpp"
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace opt {
+namespace impl::expr {
+
+struct expression_tag {};
+
+template <class T>
+concept Expression = std::derived_from<T, expression_tag>;
+
+template <class T>
+concept Entity = Point<T> || Vector<T>;
+
+/// Leaf of an expression, referring to an existing point or vector
+template <Entity E>
+struct terminal : expression_tag {
+    using result_type = E;
+
+    const E* ref{};
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {
+        return dimension(*ref);
+    }
+    [[nodiscard]] constexpr auto operator[](std::size_t i) const
+        -> decltype(auto)
+    {
+        return (*ref)[i];
+    }
+};
+
+template <class Op, class L, class R>
+concept ElementwiseInvocable = requires(const L& l, const R& r) {
+    Op{}(l, r);
+};
+
+/// Coordinate-wise binary operation, typed after the eager operation
+template <Expression L, Expression R, class Op>
+    requires ElementwiseInvocable<Op,
+                                  typename L::result_type,
+                                  typename R::result_type>
+struct binary : expression_tag {
+    using result_type = std::remove_cvref_t<
+        std::invoke_result_t<Op,
+                             const typename L::result_type&,
+                             const typename R::result_type&>>;
+
+    L lhs;
+    R rhs;
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {
+        assert(lhs.size() == rhs.size());
+        return lhs.size();
+    }
+    [[nodiscard]] constexpr auto operator[](std::size_t i) const
+    {
+        return Op{}(lhs[i], rhs[i]);
+    }
+};
+
+template <Expression E>
+struct negated : expression_tag {
+    using result_type = typename E::result_type;
+
+    E arg;
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {
+        return arg.size();
+    }
+    [[nodiscard]] constexpr auto operator[](std::size_t i) const
+    {
+        return -arg[i];
+    }
+};
+
+template <Expression E>
+struct scaled : expression_tag {
+    using result_type = typename E::result_type;
+
+    scalar_t<result_type> s;
+    E arg;
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {
+        return arg.size();
+    }
+    [[nodiscard]] constexpr auto operator[](std::size_t i) const
+    {
+        return s * arg[i];
+    }
+};
+
+template <class T>
+concept Operand = Expression<T> || Entity<T>;
+
+template <Operand T>
+[[nodiscard]] constexpr auto as_expression(const T& x)
+{
+    if constexpr (Expression<T>) {
+        return x;
+    } else {
+        return terminal<T>{{}, &x};
+    }
+}
+
+template <Operand T>
+using as_expression_t = decltype(as_expression(std::declval<const T&>()));
+
+template <class L, class R>
+    requires(Expression<L> || Expression<R>) && Operand<L> && Operand<R>
+[[nodiscard]] constexpr auto operator+(const L& lhs, const R& rhs)
+    -> binary<as_expression_t<L>, as_expression_t<R>, std::plus<>>
+{
+    return {{}, as_expression(lhs), as_expression(rhs)};
+}
+
+template <class L, class R>
+    requires(Expression<L> || Expression<R>) && Operand<L> && Operand<R>
+[[nodiscard]] constexpr auto operator-(const L& lhs, const R& rhs)
+    -> binary<as_expression_t<L>, as_expression_t<R>, std::minus<>>
+{
+    return {{}, as_expression(lhs), as_expression(rhs)};
+}
+
+/// Point or vector that is not an expression, checked in that order since
+/// `Entity` looks up the operators below
+template <class T>
+concept PlainEntity = (not Expression<T>) && Entity<T>;
+
+// Points and vectors are referred to, not copied, so temporaries would
+// dangle once the full-expression ends
+template <class L, class R>
+    requires Expression<L> && PlainEntity<R>
+auto operator+(const L&, const R&&) = delete;
+template <class L, class R>
+    requires Expression<R> && PlainEntity<L>
+auto operator+(const L&&, const R&) = delete;
+template <class L, class R>
+    requires Expression<L> && PlainEntity<R>
+auto operator-(const L&, const R&&) = delete;
+template <class L, class R>
+    requires Expression<R> && PlainEntity<L>
+auto operator-(const L&&, const R&) = delete;
+
+template <Expression E>
+[[nodiscard]] constexpr auto operator-(const E& e) -> negated<E>
+{
+    return {{}, e};
+}
+
+template <Expression E>
+[[nodiscard]] constexpr auto
+operator*(const scalar_t<typename E::result_type>& s, const E& e) -> scaled<E>
+{
+    return {{}, s, e};
+}
+
+template <Expression E>
+[[nodiscard]] constexpr auto
+operator*(const E& e, const scalar_t<typename E::result_type>& s) -> scaled<E>
+{
+    return {{}, s, e};
+}
+
+/// `x + s * y`, evaluated by `impl::simd::axpy` when possible
+template <class E>
+struct is_axpy : std::false_type {};
+template <class X, class Y>
+struct is_axpy<binary<terminal<X>, scaled<terminal<Y>>, std::plus<>>>
+    : std::bool_constant<detail::simd_contiguous<X> and
+                         detail::simd_contiguous<Y>> {};
+
+}  // namespace impl::expr
+
+/// Defers arithmetic on `x` so that a whole expression is evaluated in a
+/// single loop without intermediate points or vectors
+///
+/// Coordinates are computed with the same operations, in the same order, as
+/// the eager operators.
+template <impl::expr::Entity T>
+[[nodiscard]] constexpr auto lazy(const T& x) -> impl::expr::terminal<T>
+{
+    return {{}, &x};
+}
+
+template <impl::expr::Entity T>
+auto lazy(const T&&) = delete;
+
+/// Writes the coordinates of `e` into `dst`
+///
+/// Each coordinate of `e` only reads the same coordinate of its operands, so
+/// `dst` may appear in `e`.
+template <class T, impl::expr::Expression E>
+    requires std::same_as<T, typename E::result_type>
+constexpr auto assign(T& dst, const E& e) -> T&
+{
+    assert(dimension(dst) == e.size());
+    if constexpr (impl::expr::is_axpy<E>::value) {
+        if (not std::is_constant_evaluated()) {
+            impl::simd::axpy(e.lhs.ref->data.data(),
+                             e.rhs.s,
+                             e.rhs.arg.ref->data.data(),
+                             dst.data.data(),
+                             e.size());
+            return dst;
+        }
+    }
+    for (std::size_t i{0}; i < e.size(); ++i) {
+        dst[i] = e[i];
+    }
+    return dst;
+}
+
+/// Evaluates `e` into a new point or vector
+template <impl::expr::Expression E>
+[[nodiscard]] constexpr auto eval(const E& e) -> typename E::result_type
+{
+    auto r = detail::make_zero<typename E::result_type>(e.size());
+    assign(r, e);
+    return r;
+}
+
+}  // namespace opt
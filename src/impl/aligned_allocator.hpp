@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace opt::impl {
+
+/// Allocator returning storage aligned to `Alignment` bytes
+///
+/// Falls back to `std::allocator` during constant evaluation.
+template <class T, std::size_t Alignment = 64>
+struct aligned_allocator {
+    static_assert(Alignment >= alignof(T));
+    static_assert((Alignment & (Alignment - 1)) == 0,
+                  "Alignment must be a power of two");
+
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    static constexpr std::size_t alignment = Alignment;
+
+    template <class U>
+    struct rebind {
+        using other = aligned_allocator<U, Alignment>;
+    };
+
+    aligned_allocator() = default;
+
+    template <class U>
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    constexpr aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept
+    {}
+
+    [[nodiscard]] constexpr auto allocate(std::size_t n) -> T*
+    {
+        if (std::is_constant_evaluated()) {
+            return std::allocator<T>{}.allocate(n);
+        }
+        return static_cast<T*>(
+            ::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    constexpr auto deallocate(T* p, std::size_t n) noexcept -> void
+    {
+        if (std::is_constant_evaluated()) {
+            std::allocator<T>{}.deallocate(p, n);
+            return;
+        }
+        ::operator delete(p, n * sizeof(T), std::align_val_t{Alignment});
+    }
+
+    template <class U>
+    [[nodiscard]] friend constexpr auto
+    operator==(const aligned_allocator&, const aligned_allocator<U, Alignment>&)
+        -> bool
+    {
+        return true;
+    }
+};
+
+}  // namespace opt::impl
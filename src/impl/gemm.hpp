@@ -0,0 +1,226 @@
+#pragma once
+
+#include "aligned_allocator.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// Matrix-matrix multiply `C += A B` on column major `float` and `double`
+/// storage
+///
+/// Follows the layout of the BLIS and GotoBLAS kernels: blocks of `A` and
+/// `B` sized for the caches are packed into contiguous panels, and a
+/// register tiled micro-kernel computes an `mr`x`nr` tile of `C` from one
+/// panel of each. Matrices are passed as functions from a column index to a
+/// pointer to the column, so columns need not be adjacent in memory.
+namespace opt::impl::gemm {
+
+using simd::Vectorizable;
+
+template <Vectorizable T>
+struct blocking {
+    /// Rows of a micro tile, two registers with SIMD
+    static constexpr std::size_t mr = [] {
+        if constexpr (simd::enabled) {
+            return 2 * simd::pack<T>::width;
+        } else {
+            return std::size_t{4};
+        }
+    }();
+    /// Columns of a micro tile
+    static constexpr std::size_t nr = simd::enabled ? 6 : 4;
+    /// Depth of the packed panels, a panel of `B` stays in L1
+    static constexpr std::size_t kc = 256;
+    /// Rows of a packed block of `A`, which stays in L2
+    static constexpr std::size_t mc = 128;
+    /// Columns of a packed block of `B`
+    static constexpr std::size_t nc = 2048;
+
+    static_assert(mc % mr == 0);
+};
+
+/// Largest product of the dimensions for which packing costs more than it
+/// saves
+inline constexpr std::size_t small_size = 16 * 16 * 16;
+
+template <Vectorizable T>
+using tile = std::array<T, blocking<T>::mr * blocking<T>::nr>;
+
+template <Vectorizable T>
+using buffer = std::vector<T, aligned_allocator<T>>;
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+/// Copies rows `[i0, i0 + m)` and columns `[k0, k0 + k)` of `a` into panels
+/// of `mr` rows, each stored `k` times `mr` contiguous entries, padding the
+/// last panel with zeros
+template <Vectorizable T, class A>
+auto pack_a(const A& a,
+            std::size_t i0,
+            std::size_t m,
+            std::size_t k0,
+            std::size_t k,
+            T* dst) -> void
+{
+    constexpr auto mr = blocking<T>::mr;
+
+    for (std::size_t ir{0}; ir < m; ir += mr) {
+        const auto rows = std::min(mr, m - ir);
+        for (std::size_t p{0}; p < k; ++p) {
+            const T* col = a(k0 + p) + i0 + ir;
+            std::copy(col, col + rows, dst);
+            std::fill(dst + rows, dst + mr, T{});
+            dst += mr;
+        }
+    }
+}
+
+/// Copies rows `[k0, k0 + k)` and columns `[j0, j0 + n)` of `b` into panels
+/// of `nr` columns, each stored `k` times `nr` contiguous entries, padding
+/// the last panel with zeros
+template <Vectorizable T, class B>
+auto pack_b(const B& b,
+            std::size_t k0,
+            std::size_t k,
+            std::size_t j0,
+            std::size_t n,
+            T* dst) -> void
+{
+    constexpr auto nr = blocking<T>::nr;
+
+    for (std::size_t jr{0}; jr < n; jr += nr) {
+        const auto cols = std::min(nr, n - jr);
+        for (std::size_t j{0}; j < nr; ++j) {
+            if (j < cols) {
+                const T* col = b(j0 + jr + j) + k0;
+                for (std::size_t p{0}; p < k; ++p) {
+                    dst[p * nr + j] = col[p];
+                }
+            } else {
+                for (std::size_t p{0}; p < k; ++p) {
+                    dst[p * nr + j] = T{};
+                }
+            }
+        }
+        dst += k * nr;
+    }
+}
+
+/// Writes the product of a packed panel of `A` and a packed panel of `B`,
+/// both of depth `k`, into `c` in column major order
+template <Vectorizable T>
+auto micro_kernel(std::size_t k, const T* a, const T* b, tile<T>& c) -> void
+{
+    constexpr auto mr = blocking<T>::mr;
+    constexpr auto nr = blocking<T>::nr;
+
+    if constexpr (simd::enabled) {
+        using P = simd::pack<T>;
+        constexpr auto w = P::width;
+
+        // A plain array, std::array would drop the alignment of the register
+        // type. Loops over it are unrolled so that it stays in registers.
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+        typename P::reg acc[2 * nr];
+        const auto unrolled = [](auto f) {
+            [&f]<std::size_t... J>(std::index_sequence<J...>) {
+                (f(std::integral_constant<std::size_t, J>{}), ...);
+            }(std::make_index_sequence<nr>{});
+        };
+
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+        unrolled([&acc](auto j) {
+            acc[2 * j] = P::zero();
+            acc[2 * j + 1] = P::zero();
+        });
+        for (std::size_t p{0}; p < k; ++p) {
+            const auto a0 = P::load(a + p * mr);
+            const auto a1 = P::load(a + p * mr + w);
+            unrolled([&acc, &a0, &a1, bp = b + p * nr](auto j) {
+                const auto bj = P::broadcast(bp[j]);
+                acc[2 * j] = P::fmadd(a0, bj, acc[2 * j]);
+                acc[2 * j + 1] = P::fmadd(a1, bj, acc[2 * j + 1]);
+            });
+        }
+        unrolled([&acc, &c](auto j) {
+            P::store(c.data() + j * mr, acc[2 * j]);
+            P::store(c.data() + j * mr + w, acc[2 * j + 1]);
+        });
+        // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+    } else {
+        c.fill(T{});
+        for (std::size_t p{0}; p < k; ++p) {
+            for (std::size_t j{0}; j < nr; ++j) {
+                const auto bj = b[p * nr + j];
+                for (std::size_t i{0}; i < mr; ++i) {
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+                    c[j * mr + i] += a[p * mr + i] * bj;
+                }
+            }
+        }
+    }
+}
+
+/// `C += A B` for the `m`x`k` matrix `a`, the `k`x`n` matrix `b` and the
+/// `m`x`n` matrix `c`
+///
+/// `a`, `b` and `c` map a column index to a pointer to its first entry.
+template <Vectorizable T, class A, class B, class C>
+auto multiply(std::size_t m,
+              std::size_t n,
+              std::size_t k,
+              const A& a,
+              const B& b,
+              const C& c) -> void
+{
+    using bl = blocking<T>;
+    constexpr auto round_up = [](std::size_t x, std::size_t r) {
+        return (x + r - 1) / r * r;
+    };
+
+    auto a_panels =
+        buffer<T>(round_up(std::min(m, bl::mc), bl::mr) * std::min(k, bl::kc));
+    auto b_panels =
+        buffer<T>(round_up(std::min(n, bl::nc), bl::nr) * std::min(k, bl::kc));
+    auto t = tile<T>{};
+
+    for (std::size_t jc{0}; jc < n; jc += bl::nc) {
+        const auto nb = std::min(bl::nc, n - jc);
+        for (std::size_t pc{0}; pc < k; pc += bl::kc) {
+            const auto kb = std::min(bl::kc, k - pc);
+            pack_b(b, pc, kb, jc, nb, b_panels.data());
+
+            for (std::size_t ic{0}; ic < m; ic += bl::mc) {
+                const auto mb = std::min(bl::mc, m - ic);
+                pack_a(a, ic, mb, pc, kb, a_panels.data());
+
+                for (std::size_t jr{0}; jr < nb; jr += bl::nr) {
+                    const auto cols = std::min(bl::nr, nb - jr);
+                    for (std::size_t ir{0}; ir < mb; ir += bl::mr) {
+                        const auto rows = std::min(bl::mr, mb - ir);
+                        micro_kernel(kb,
+                                     a_panels.data() + ir * kb,
+                                     b_panels.data() + jr * kb,
+                                     t);
+                        for (std::size_t j{0}; j < cols; ++j) {
+                            T* cj = c(jc + jr + j) + ic + ir;
+                            for (std::size_t i{0}; i < rows; ++i) {
+                                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+                                cj[i] += t[j * bl::mr + i];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+}  // namespace opt::impl::gemm
@@ -0,0 +1,278 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <numeric>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/// Explicitly vectorized kernels on contiguous `float` and `double` arrays
+///
+/// The instruction set is chosen at compile time from the target macros
+/// (AVX-512F, then AVX2), with a scalar fallback. Element-wise kernels
+/// perform the same operations as the scalar loops and give bit-identical
+/// results; reductions use several partial sums and may round differently.
+/// `pack::fmadd` rounds once when FMA is available and is only used where
+/// results are not expected to match a scalar loop.
+namespace opt::impl::simd {
+
+template <class T>
+concept Vectorizable = std::same_as<T, float> || std::same_as<T, double>;
+
+template <Vectorizable T>
+struct pack;
+
+#if defined(__AVX512F__)
+
+inline constexpr bool enabled = true;
+
+template <>
+struct pack<float> {
+    using reg = __m512;
+    static constexpr std::size_t width = 16;
+
+    static auto load(const float* p) -> reg { return _mm512_loadu_ps(p); }
+    static auto store(float* p, reg x) -> void { _mm512_storeu_ps(p, x); }
+    static auto broadcast(float x) -> reg { return _mm512_set1_ps(x); }
+    static auto zero() -> reg { return _mm512_setzero_ps(); }
+    static auto add(reg x, reg y) -> reg { return _mm512_add_ps(x, y); }
+    static auto sub(reg x, reg y) -> reg { return _mm512_sub_ps(x, y); }
+    static auto mul(reg x, reg y) -> reg { return _mm512_mul_ps(x, y); }
+    static auto fmadd(reg x, reg y, reg z) -> reg
+    {
+        return _mm512_fmadd_ps(x, y, z);
+    }
+    static auto sum(reg x) -> float
+    {
+        // _mm512_reduce_add_ps trips -Wuninitialized in some GCC headers
+        alignas(64) std::array<float, width> lanes{};
+        _mm512_store_ps(lanes.data(), x);
+        return std::reduce(lanes.begin(), lanes.end());
+    }
+};
+
+template <>
+struct pack<double> {
+    using reg = __m512d;
+    static constexpr std::size_t width = 8;
+
+    static auto load(const double* p) -> reg { return _mm512_loadu_pd(p); }
+    static auto store(double* p, reg x) -> void { _mm512_storeu_pd(p, x); }
+    static auto broadcast(double x) -> reg { return _mm512_set1_pd(x); }
+    static auto zero() -> reg { return _mm512_setzero_pd(); }
+    static auto add(reg x, reg y) -> reg { return _mm512_add_pd(x, y); }
+    static auto sub(reg x, reg y) -> reg { return _mm512_sub_pd(x, y); }
+    static auto mul(reg x, reg y) -> reg { return _mm512_mul_pd(x, y); }
+    static auto fmadd(reg x, reg y, reg z) -> reg
+    {
+        return _mm512_fmadd_pd(x, y, z);
+    }
+    static auto sum(reg x) -> double
+    {
+        alignas(64) std::array<double, width> lanes{};
+        _mm512_store_pd(lanes.data(), x);
+        return std::reduce(lanes.begin(), lanes.end());
+    }
+};
+
+#elif defined(__AVX2__)
+
+inline constexpr bool enabled = true;
+
+template <>
+struct pack<float> {
+    using reg = __m256;
+    static constexpr std::size_t width = 8;
+
+    static auto load(const float* p) -> reg { return _mm256_loadu_ps(p); }
+    static auto store(float* p, reg x) -> void { _mm256_storeu_ps(p, x); }
+    static auto broadcast(float x) -> reg { return _mm256_set1_ps(x); }
+    static auto zero() -> reg { return _mm256_setzero_ps(); }
+    static auto add(reg x, reg y) -> reg { return _mm256_add_ps(x, y); }
+    static auto sub(reg x, reg y) -> reg { return _mm256_sub_ps(x, y); }
+    static auto mul(reg x, reg y) -> reg { return _mm256_mul_ps(x, y); }
+    static auto fmadd(reg x, reg y, reg z) -> reg
+    {
+#if defined(__FMA__)
+        return _mm256_fmadd_ps(x, y, z);
+#else
+        return add(mul(x, y), z);
+#endif
+    }
+    static auto sum(reg x) -> float
+    {
+        auto s = _mm_add_ps(_mm256_castps256_ps128(x),
+                            _mm256_extractf128_ps(x, 1));
+        s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        s = _mm_add_ss(s, _mm_movehdup_ps(s));
+        return _mm_cvtss_f32(s);
+    }
+};
+
+template <>
+struct pack<double> {
+    using reg = __m256d;
+    static constexpr std::size_t width = 4;
+
+    static auto load(const double* p) -> reg { return _mm256_loadu_pd(p); }
+    static auto store(double* p, reg x) -> void { _mm256_storeu_pd(p, x); }
+    static auto broadcast(double x) -> reg { return _mm256_set1_pd(x); }
+    static auto zero() -> reg { return _mm256_setzero_pd(); }
+    static auto add(reg x, reg y) -> reg { return _mm256_add_pd(x, y); }
+    static auto sub(reg x, reg y) -> reg { return _mm256_sub_pd(x, y); }
+    static auto mul(reg x, reg y) -> reg { return _mm256_mul_pd(x, y); }
+    static auto fmadd(reg x, reg y, reg z) -> reg
+    {
+#if defined(__FMA__)
+        return _mm256_fmadd_pd(x, y, z);
+#else
+        return add(mul(x, y), z);
+#endif
+    }
+    static auto sum(reg x) -> double
+    {
+        auto s = _mm_add_pd(_mm256_castpd256_pd128(x),
+                            _mm256_extractf128_pd(x, 1));
+        s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+        return _mm_cvtsd_f64(s);
+    }
+};
+
+#else
+
+inline constexpr bool enabled = false;
+
+#endif
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+/// r[i] = x[i] + y[i]
+template <Vectorizable T>
+auto add(const T* x, const T* y, T* r, std::size_t n) -> void
+{
+    auto i = std::size_t{};
+    if constexpr (enabled) {
+        using P = pack<T>;
+        for (const auto end = n - n % P::width; i < end; i += P::width) {
+            P::store(r + i, P::add(P::load(x + i), P::load(y + i)));
+        }
+    }
+    for (; i < n; ++i) {
+        r[i] = x[i] + y[i];
+    }
+}
+
+/// r[i] = x[i] - y[i]
+template <Vectorizable T>
+auto sub(const T* x, const T* y, T* r, std::size_t n) -> void
+{
+    auto i = std::size_t{};
+    if constexpr (enabled) {
+        using P = pack<T>;
+        for (const auto end = n - n % P::width; i < end; i += P::width) {
+            P::store(r + i, P::sub(P::load(x + i), P::load(y + i)));
+        }
+    }
+    for (; i < n; ++i) {
+        r[i] = x[i] - y[i];
+    }
+}
+
+/// r[i] = s * x[i]
+template <Vectorizable T>
+auto scale(T s, const T* x, T* r, std::size_t n) -> void
+{
+    auto i = std::size_t{};
+    if constexpr (enabled) {
+        using P = pack<T>;
+        const auto ps = P::broadcast(s);
+        for (const auto end = n - n % P::width; i < end; i += P::width) {
+            P::store(r + i, P::mul(ps, P::load(x + i)));
+        }
+    }
+    for (; i < n; ++i) {
+        r[i] = s * x[i];
+    }
+}
+
+/// r[i] = x[i] + s * y[i], rounding the product and the sum separately
+template <Vectorizable T>
+auto axpy(const T* x, T s, const T* y, T* r, std::size_t n) -> void
+{
+    auto i = std::size_t{};
+    if constexpr (enabled) {
+        using P = pack<T>;
+        const auto ps = P::broadcast(s);
+        for (const auto end = n - n % P::width; i < end; i += P::width) {
+            P::store(r + i,
+                     P::add(P::load(x + i), P::mul(ps, P::load(y + i))));
+        }
+    }
+    for (; i < n; ++i) {
+        r[i] = x[i] + s * y[i];
+    }
+}
+
+template <Vectorizable T>
+auto dot_scalar(const T* x, const T* y, std::size_t n) -> T
+{
+    auto r = T{};
+    for (auto i = std::size_t{}; i < n; ++i) {
+        r += x[i] * y[i];
+    }
+    return r;
+}
+
+/// Sum of x[i] * y[i]
+template <Vectorizable T>
+auto dot(const T* x, const T* y, std::size_t n) -> T
+{
+    auto i = std::size_t{};
+    auto r = T{};
+    if constexpr (enabled) {
+        using P = pack<T>;
+        if (n < P::width) {
+            return dot_scalar(x, y, n);
+        }
+        constexpr auto unroll = 4 * P::width;
+
+        auto acc0 = P::zero();
+        auto acc1 = P::zero();
+        auto acc2 = P::zero();
+        auto acc3 = P::zero();
+        for (; i + unroll <= n; i += unroll) {
+            acc0 = P::add(acc0, P::mul(P::load(x + i), P::load(y + i)));
+            acc1 = P::add(acc1,
+                          P::mul(P::load(x + i + P::width),
+                                 P::load(y + i + P::width)));
+            acc2 = P::add(acc2,
+                          P::mul(P::load(x + i + 2 * P::width),
+                                 P::load(y + i + 2 * P::width)));
+            acc3 = P::add(acc3,
+                          P::mul(P::load(x + i + 3 * P::width),
+                                 P::load(y + i + 3 * P::width)));
+        }
+        for (const auto end = n - n % P::width; i < end; i += P::width) {
+            acc0 = P::add(acc0, P::mul(P::load(x + i), P::load(y + i)));
+        }
+        r = P::sum(P::add(P::add(acc0, acc1), P::add(acc2, acc3)));
+    }
+    for (; i < n; ++i) {
+        r += x[i] * y[i];
+    }
+    return r;
+}
+
+/// Sum of x[i] * x[i]
+template <Vectorizable T>
+auto squared_norm(const T* x, std::size_t n) -> T
+{
+    return dot(x, x, n);
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+}  // namespace opt::impl::simd
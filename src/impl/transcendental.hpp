@@ -0,0 +1,552 @@
+#pragma once
+
+#include "src/stdx/cmath.hpp"
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+/// Elementary functions of `float` and `double`, usable in constant
+/// expressions
+///
+/// Arguments are reduced to a small interval, on which a polynomial is
+/// evaluated, and the result is rescaled. The polynomials are near minimax,
+/// obtained by Chebyshev economization of the Taylor series on the reduced
+/// interval. All evaluations are done in `double`, with polynomials of lower
+/// degree for `float` results, so that `float` results are almost always
+/// correctly rounded and `double` results are within about one ulp.
+///
+/// Special cases are handled with selects rather than branches, so that the
+/// functions compile to straight-line code which vectorizes in loops.
+namespace opt::impl::transcendental {
+
+template <class T>
+concept Supported = std::same_as<T, float> or std::same_as<T, double>;
+
+/// Whether polynomials may be truncated to the precision of `float`
+template <Supported T>
+inline constexpr bool single = std::same_as<T, float>;
+
+/// Kernels computing in `double` for results of type `T`
+namespace kernel {
+
+inline constexpr auto inf = std::numeric_limits<double>::infinity();
+inline constexpr auto nan = std::numeric_limits<double>::quiet_NaN();
+
+/// ln 2 split so that `n * ln2_hi` is exact for `|n| < 2^21`
+inline constexpr double ln2_hi = 0x1.62e42ffp-1;
+inline constexpr double ln2_lo = -0x1.718432a1b0e26p-35;
+inline constexpr double inv_ln2 = 0x1.71547652b82fep0;
+
+/// pi / 2 split so that `n * pio2_1` and `n * pio2_2` are exact for
+/// `|n| < 2^20`
+inline constexpr double pio2_1 = 0x1.921fb544p0;
+inline constexpr double pio2_2 = 0x1.0b4611a6p-34;
+inline constexpr double pio2_3 = 0x1.3198a2e037073p-69;
+inline constexpr double two_over_pi = 0x1.45f306dc9c883p-1;
+/// Largest argument of the trigonometric functions for which the reduction
+/// by `pio2_*` is accurate
+inline constexpr double trig_limit = 0x1p19 * 0x1.921fb54442d18p0;
+
+// Coefficients of `g(r) = (expm1(r) - r) / r^2` on `|r| <= ln 2 / 2`, with
+// an absolute error below 2.7e-11 and 1.4e-18
+inline constexpr auto expm1_float = std::array{0.49999999999955097,
+                                               0.16666666719007714,
+                                               0.04166666678628104,
+                                               0.008333298480356209,
+                                               0.0013888839107173761,
+                                               0.00019899276222384887,
+                                               2.486787206587467e-05};
+inline constexpr auto expm1_double = std::array{0.5,
+                                                0.1666666666666667,
+                                                0.04166666666666668,
+                                                0.008333333333326141,
+                                                0.0013888888888879082,
+                                                0.00019841269874802173,
+                                                2.4801587336422683e-05,
+                                                2.755725542387984e-06,
+                                                2.755726330017862e-07,
+                                                2.510520706464424e-08,
+                                                2.091812988660952e-09};
+
+// Coefficients of `(sin(r) - r) / r^3` and `(cos(r) - 1 + r^2 / 2) / r^4` as
+// polynomials of `z = r^2`, on `|r| <= pi / 4`, with an absolute error below
+// 2.9e-11 and 2.1e-17
+inline constexpr auto sin_float = std::array{-0.16666666663858068,
+                                             0.008333331875520714,
+                                             -0.00019840087085697616,
+                                             2.7249963658800812e-06};
+inline constexpr auto sin_double = std::array{-0.16666666666666666,
+                                              0.00833333333333095,
+                                              -0.0001984126983675979,
+                                              2.7557316103105014e-06,
+                                              -2.5051131947374594e-08,
+                                              1.5918135932869774e-10};
+inline constexpr auto cos_float = std::array{0.04166666666432319,
+                                             -0.0013888887672596337,
+                                             2.480060062765224e-05,
+                                             -2.730098627353618e-07};
+inline constexpr auto cos_double = std::array{0.041666666666666664,
+                                              -0.0013888888888887398,
+                                              2.4801587298766363e-05,
+                                              -2.7557317272036996e-07,
+                                              2.087614632531677e-09,
+                                              -1.1382636115964061e-11};
+
+// Coefficients of `(log((1 + s) / (1 - s)) - 2 s) / s^3` as polynomials of
+// `z = s^2`, on `|s| <= (sqrt(2) - 1) / (sqrt(2) + 1)`, with an absolute
+// error below 1.2e-9 and 3.1e-16
+inline constexpr auto log_float = std::array{0.6666666655378406,
+                                             0.4000012227736827,
+                                             0.28550781106736645,
+                                             0.2333136748376657};
+inline constexpr auto log_double = std::array{0.666666666666667,
+                                              0.39999999999899005,
+                                              0.28571428626173057,
+                                              0.2222221110612709,
+                                              0.1818289100504977,
+                                              0.1533166479930626,
+                                              0.14617093237558207};
+
+template <std::size_t N>
+[[nodiscard]] constexpr auto horner(double x, const std::array<double, N>& c)
+    -> double
+{
+    auto r = c.back();
+    for (auto i = N - 1; i-- > 0;) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        r = r * x + c[i];
+    }
+    return r;
+}
+
+[[nodiscard]] constexpr auto select(bool b, double x, double y) -> double
+{
+    return b ? x : y;
+}
+
+// Integers are kept in doubles and their bits are read by adding
+// `round_shift`, as conversions between doubles and 64 bit integers don't
+// vectorize without AVX-512
+
+/// Adding it to `x` with `|x| < 2^51` rounds `x` to an integer `n`, and leaves
+/// `n + 2^51` in the low bits of the sum
+inline constexpr double round_shift = 0x1.8p52;
+
+/// Nearest integer to `x`, for `|x| < 2^51`
+[[nodiscard]] constexpr auto round_nearest(double x) -> double
+{
+    return (x + round_shift) - round_shift;
+}
+
+/// Integer `n` modulo 2^51, for `|n| < 2^51`
+[[nodiscard]] constexpr auto integer_bits(double n) -> std::uint64_t
+{
+    constexpr auto offset = std::uint64_t{1} << 51U;
+    return std::bit_cast<std::uint64_t>(n + round_shift) - offset;
+}
+
+/// `2^n` for integer `n` in `[-1022, 1023]`
+[[nodiscard]] constexpr auto pow2(double n) -> double
+{
+    return std::bit_cast<double>((integer_bits(n) + 1023U) << 52U);
+}
+
+/// `x * 2^n` for integer `n` in `[-2044, 2046]`, with a single rounding
+[[nodiscard]] constexpr auto scale(double x, double n) -> double
+{
+    const auto half = round_nearest(0.5 * n);
+    return x * pow2(half) * pow2(n - half);
+}
+
+/// `x * y` as the sum of the rounded product and its rounding error
+[[nodiscard]] constexpr auto two_product(double x, double y)
+    -> std::pair<double, double>
+{
+    // Veltkamp splitting, as std::fma is not usable in constant expressions
+    constexpr auto split = [](double a) {
+        constexpr auto factor = 0x1p27 + 1;
+        const auto c = factor * a;
+        const auto hi = c - (c - a);
+        return std::pair{hi, a - hi};
+    };
+    const auto p = x * y;
+    const auto [xh, xl] = split(x);
+    const auto [yh, yl] = split(y);
+    return {p, ((xh * yh - p) + xh * yl + xl * yh) + xl * yl};
+}
+
+/// `x + y` as the sum of the rounded sum and its rounding error
+[[nodiscard]] constexpr auto two_sum(double x, double y)
+    -> std::pair<double, double>
+{
+    const auto s = x + y;
+    const auto v = s - x;
+    return {s, (x - (s - v)) + (y - v)};
+}
+
+/// `expm1(r)` for `|r| <= ln 2 / 2`
+template <Supported T>
+[[nodiscard]] constexpr auto expm1_reduced(double r) -> double
+{
+    if constexpr (single<T>) {
+        return r + r * r * horner(r, expm1_float);
+    } else {
+        return r + r * r * horner(r, expm1_double);
+    }
+}
+
+/// Writes `hi + lo` as `n ln 2 + r` with `|r| <= ln 2 / 2`, for `hi` in
+/// `[-1400, 1400]`
+[[nodiscard]] constexpr auto reduce_ln2(double hi, double lo)
+    -> std::pair<double, double>
+{
+    const auto n = round_nearest(hi * inv_ln2);
+    return {n, (hi - n * ln2_hi) + (lo - n * ln2_lo)};
+}
+
+/// Largest argument of `exp` with a finite result of type `T`
+template <Supported T>
+inline constexpr double max_log =
+    single<T> ? 0x1.62e42ep6 : 0x1.62e42fefa39efp9;
+
+/// `exp(hi + lo)`, where `lo` is much smaller than `hi`
+template <Supported T>
+[[nodiscard]] constexpr auto exp(double hi, double lo) -> double
+{
+    // Arguments are clamped so that no intermediate overflows, which is an
+    // error during constant evaluation, NaN is mapped to the lower bound
+    const auto clamped = select(hi > -1400.0, hi, -1400.0);
+    const auto x = select(clamped < max_log<T>, clamped, max_log<T>);
+    const auto [n, r] = reduce_ln2(x, select(x == hi, lo, 0.0));
+    const auto y = scale(1.0 + expm1_reduced<T>(r), n);
+
+    return select(hi != hi, hi, select(hi > max_log<T>, inf, y));
+}
+
+/// `expm1(x)`
+template <Supported T>
+[[nodiscard]] constexpr auto expm1(double x) -> double
+{
+    // Below -60, the result rounds to -1
+    const auto clamped = select(x > -60.0, x, -60.0);
+    const auto xc = select(clamped < max_log<T>, clamped, max_log<T>);
+    const auto [n, r] = reduce_ln2(xc, 0.0);
+
+    // 2^n (1 + p) - 1 written as (p + (1 - 2^-n)) 2^n, which is exact for
+    // n = 0 and avoids cancellation otherwise
+    const auto m = select(n < 1022.0, -n, -1022.0);
+    const auto y = scale(expm1_reduced<T>(r) + (1.0 - pow2(m)), n);
+
+    return select(x != x or x == 0.0, x, select(x > max_log<T>, inf, y));
+}
+
+struct log_terms {
+    double e{};
+    double f{};
+    double c{};
+};
+
+/// Terms of `log(x)` for finite positive normal `x`
+///
+/// Returns `e`, `f` and `c` such that `log(x) = e ln2_hi + f - hf + c` with
+/// `hf = f^2 / 2` and `f` exact.
+template <Supported T>
+[[nodiscard]] constexpr auto reduce_log(double x) -> log_terms
+{
+    // x = 2^e m with m in [sqrt(2) / 2, sqrt(2)), the 12 bits of e are read
+    // as a double through the exponent of 2^52
+    constexpr auto sqrt_half =
+        std::bit_cast<std::uint64_t>(0x1.6a09e667f3bcdp-1);
+    constexpr auto two52 = std::bit_cast<std::uint64_t>(0x1p52);
+    const auto bits = std::bit_cast<std::uint64_t>(x);
+    const auto e_bits = (bits - sqrt_half) >> 52U;
+    const auto m = std::bit_cast<double>(bits - (e_bits << 52U));
+    const auto e_low = std::bit_cast<double>(e_bits | two52) - 0x1p52;
+    const auto e = select(e_low >= 2048.0, e_low - 4096.0, e_low);
+
+    const auto f = m - 1.0;
+    const auto s = f / (2.0 + f);
+    const auto z = s * s;
+    const auto hf = 0.5 * f * f;
+
+    const auto r = [z] {
+        if constexpr (single<T>) {
+            return z * horner(z, log_float);
+        } else {
+            return z * horner(z, log_double);
+        }
+    }();
+    return {e, f, s * (hf + r) + e * ln2_lo};
+}
+
+/// Maps non positive, subnormal and non finite arguments of `log` to normal
+/// ones, returning the argument and the power of two it was scaled by
+[[nodiscard]] constexpr auto normalize_log(double x)
+    -> std::pair<double, double>
+{
+    constexpr auto min = std::numeric_limits<double>::min();
+    constexpr auto max = std::numeric_limits<double>::max();
+
+    const auto tiny = x < min;
+    const auto scaled = select(tiny, x * 0x1p54, x);
+    const auto valid = scaled >= min and scaled <= max;
+    return {select(valid, scaled, 1.0), select(tiny, -54.0, 0.0)};
+}
+
+/// Whether `log(x)` is zero, negative or not finite
+[[nodiscard]] constexpr auto log_special(double x) -> bool
+{
+    return not(x > 0.0 and x < inf);
+}
+
+/// `log(x)` for the arguments where `log_special(x)` is true
+[[nodiscard]] constexpr auto log_special_value(double x) -> double
+{
+    return select(x == 0.0, -inf, select(x == inf, inf, nan));
+}
+
+template <Supported T>
+[[nodiscard]] constexpr auto log(double x) -> double
+{
+    const auto [xn, shift] = normalize_log(x);
+    const auto [e, f, c] = reduce_log<T>(xn);
+    const auto k = e + shift;
+    const auto hf = 0.5 * f * f;
+    const auto y = k * ln2_hi - ((hf - (c + shift * ln2_lo)) - f);
+
+    return select(log_special(x), log_special_value(x), y);
+}
+
+/// `log(x)` as `hi + lo` with about 70 bits of precision
+template <Supported T>
+[[nodiscard]] constexpr auto log_extended(double x)
+    -> std::pair<double, double>
+{
+    const auto [xn, shift] = normalize_log(x);
+    const auto [e, f, c] = reduce_log<T>(xn);
+    const auto k = e + shift;
+
+    const auto [hf_hi, hf_lo] = two_product(f, 0.5 * f);
+    const auto [a, a_err] = two_sum(k * ln2_hi, f);
+    const auto [b, b_err] = two_sum(a, -hf_hi);
+    const auto rest = ((c + shift * ln2_lo) - hf_lo) + (a_err + b_err);
+    const auto hi = b + rest;
+
+    const auto special = log_special(x);
+    return {select(special, log_special_value(x), hi),
+            select(special, 0.0, rest - (hi - b))};
+}
+
+template <Supported T>
+[[nodiscard]] constexpr auto log1p(double x) -> double
+{
+    // The rounding error of 1 + x is corrected to first order
+    const auto u = 1.0 + x;
+    const auto special = log_special(u);
+    const auto us = select(special, 1.0, u);
+    const auto y = log<T>(us) - ((us - 1.0) - select(special, 0.0, x)) / us;
+    return select(x == 0.0 or x != x,
+                  x,
+                  select(special, log_special_value(u), y));
+}
+
+template <Supported T>
+[[nodiscard]] constexpr auto pow(double x, double y) -> double
+{
+    const auto ax = stdx::abs(x);
+    const auto ay = stdx::abs(y);
+
+    // Every double of magnitude at least 2^52 is an even integer
+    const auto big = ay >= 0x1p52;
+    const auto integer = big or round_nearest(y) == y;
+    const auto odd = not big and integer and round_nearest(0.5 * y) != 0.5 * y;
+
+    // y log|x| is computed from finite operands, since infinities would give
+    // NaN in two_product, and with |y| <= 2^64, since |log|x|| > 2^-54 for
+    // x != 1 so that larger |y| saturate exp anyway
+    const auto [l_hi, l_lo] = log_extended<T>(ax);
+    const auto finite = ay < inf and stdx::abs(l_hi) < inf;
+    const auto yc = select(y < 0x1p64, y, 0x1p64);
+    const auto ys = select(finite, select(yc > -0x1p64, yc, -0x1p64), 0.0);
+    const auto ls = select(finite, l_hi, 0.0);
+    const auto [p, p_err] = two_product(ys, ls);
+
+    // Otherwise, exp(y log|x|) is 0 or infinite depending on the signs
+    const auto limit = select((y > 0.0) == (l_hi > 0.0), 1400.0, -1400.0);
+    const auto r = exp<T>(select(finite, p, limit),
+                          select(finite, p_err + ys * l_lo, 0.0));
+
+    // The sign bit also covers x = -0
+    const auto negative = (std::bit_cast<std::uint64_t>(x) >> 63U) != 0;
+    const auto signed_r = select(negative and odd, -r, r);
+    const auto one = y == 0.0 or x == 1.0 or (ax == 1.0 and ay == inf);
+    const auto invalid = x < 0.0 and x > -inf and not integer;
+    return select(one,
+                  1.0,
+                  select(x != x or y != y or invalid, nan, signed_r));
+}
+
+/// Writes `x` as `n pi / 2 + r` with `|r| <= pi / 4`, for `|x| <= trig_limit`
+[[nodiscard]] constexpr auto reduce_pio2(double x)
+    -> std::pair<double, double>
+{
+    const auto n = round_nearest(x * two_over_pi);
+    return {n, ((x - n * pio2_1) - n * pio2_2) - n * pio2_3};
+}
+
+template <Supported T>
+[[nodiscard]] constexpr auto sin_reduced(double r) -> double
+{
+    const auto z = r * r;
+    if constexpr (single<T>) {
+        return r + r * z * horner(z, sin_float);
+    } else {
+        return r + r * z * horner(z, sin_double);
+    }
+}
+
+template <Supported T>
+[[nodiscard]] constexpr auto cos_reduced(double r) -> double
+{
+    const auto z = r * r;
+    const auto hz = 0.5 * z;
+    const auto w = 1.0 - hz;
+    if constexpr (single<T>) {
+        return w + (((1.0 - w) - hz) + z * z * horner(z, cos_float));
+    } else {
+        return w + (((1.0 - w) - hz) + z * z * horner(z, cos_double));
+    }
+}
+
+/// Sine and cosine of `x`, for finite `|x| <= trig_limit`, and NaN for other
+/// arguments
+template <Supported T>
+[[nodiscard]] constexpr auto sincos(double x) -> std::pair<double, double>
+{
+    const auto valid = stdx::abs(x) <= trig_limit;
+    const auto [n, r] = reduce_pio2(select(valid, x, 0.0));
+    const auto s = sin_reduced<T>(r);
+    const auto c = cos_reduced<T>(r);
+
+    // sin(x) and cos(x) are +-sin(r) or +-cos(r) depending on the quadrant
+    const auto q = integer_bits(n) & 3U;
+    const auto sin_x = select((q & 1U) != 0, c, s);
+    const auto cos_x = select((q & 1U) != 0, s, c);
+    return {select(valid,
+                   select(x == 0.0, x, select((q & 2U) != 0, -sin_x, sin_x)),
+                   nan),
+            select(valid, select(((q + 1) & 2U) != 0, -cos_x, cos_x), nan)};
+}
+
+/// Whether `x` must be passed to `<cmath>` for an accurate trigonometric
+/// function, which happens only for large arguments outside of constant
+/// evaluation
+[[nodiscard]] constexpr auto trig_fallback(double x) -> bool
+{
+    return not std::is_constant_evaluated() and
+           stdx::abs(x) > trig_limit and x - x == 0.0;
+}
+
+template <Supported T>
+[[nodiscard]] constexpr auto tanh(double x) -> double
+{
+    // tanh(|x|) = -t / (t + 2) with t = expm1(-2 |x|), which is -1 for
+    // |x| > 30
+    const auto ax = stdx::abs(x);
+    const auto t = expm1<T>(-2.0 * select(ax < 30.0, ax, 30.0));
+    const auto y = -t / (t + 2.0);
+    return select(x != x or x == 0.0, x, select(x < 0.0, -y, y));
+}
+
+}  // namespace kernel
+
+template <Supported T>
+[[nodiscard]] constexpr auto exp(T x) -> T
+{
+    return static_cast<T>(kernel::exp<T>(x, 0.0));
+}
+
+template <Supported T>
+[[nodiscard]] constexpr auto expm1(T x) -> T
+{
+    return static_cast<T>(kernel::expm1<T>(x));
+}
+
+/// Natural logarithm, NaN for negative arguments
+template <Supported T>
+[[nodiscard]] constexpr auto log(T x) -> T
+{
+    return static_cast<T>(kernel::log<T>(x));
+}
+
+/// `log(1 + x)`, accurate for small `x`
+template <Supported T>
+[[nodiscard]] constexpr auto log1p(T x) -> T
+{
+    return static_cast<T>(kernel::log1p<T>(x));
+}
+
+/// `x` raised to `y`, following the special cases of `std::pow`
+template <Supported T>
+[[nodiscard]] constexpr auto pow(T x, T y) -> T
+{
+    return static_cast<T>(kernel::pow<T>(x, y));
+}
+
+/// Square root, NaN for negative arguments
+template <Supported T>
+[[nodiscard]] constexpr auto sqrt(T x) -> T
+{
+    return x < T{} or x != x ? std::numeric_limits<T>::quiet_NaN()
+                             : stdx::sqrt(x);
+}
+
+/// Sine
+///
+/// Arguments larger in magnitude than `kernel::trig_limit` are passed to
+/// `std::sin` at run time and give NaN during constant evaluation.
+template <Supported T>
+[[nodiscard]] constexpr auto sin(T x) -> T
+{
+    if (kernel::trig_fallback(x)) [[unlikely]] {
+        return std::sin(x);
+    }
+    return static_cast<T>(kernel::sincos<T>(x).first);
+}
+
+/// Cosine, with the argument range of `sin`
+template <Supported T>
+[[nodiscard]] constexpr auto cos(T x) -> T
+{
+    if (kernel::trig_fallback(x)) [[unlikely]] {
+        return std::cos(x);
+    }
+    return static_cast<T>(kernel::sincos<T>(x).second);
+}
+
+/// Tangent, computed as the quotient of the sine and cosine, with the
+/// argument range of `sin`
+template <Supported T>
+[[nodiscard]] constexpr auto tan(T x) -> T
+{
+    if (kernel::trig_fallback(x)) [[unlikely]] {
+        return std::tan(x);
+    }
+    const auto [s, c] = kernel::sincos<T>(x);
+    return static_cast<T>(s / c);
+}
+
+template <Supported T>
+[[nodiscard]] constexpr auto tanh(T x) -> T
+{
+    return static_cast<T>(kernel::tanh<T>(x));
+}
+
+}  // namespace opt::impl::transcendental
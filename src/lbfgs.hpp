@@ -0,0 +1,257 @@
+#pragma once
+
+#include "src/concepts.hpp"
+#include "src/convopt.hpp"
+#include "src/expression.hpp"
+#include "src/line_search.hpp"
+#include "src/solver_options.hpp"
+#include "src/spaces.hpp"
+#include "src/stdx/cmath.hpp"
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+namespace opt {
+namespace impl {
+
+/// The last `M` curvature pairs `s = x' - x`, `y = g' - g` of L-BFGS
+///
+/// Storage for every pair is allocated on construction, adding a pair
+/// overwrites the oldest one once the buffer is full.
+template <Vector V, std::size_t M>
+    requires(M > 0)
+class lbfgs_history {
+    using scalar_type = scalar_t<V>;
+
+    std::array<V, M> s_;
+    std::array<V, M> y_;
+    std::array<scalar_type, M> rho_{};
+    std::array<scalar_type, M> a_{};
+    std::size_t first_{};
+    std::size_t size_{};
+
+    template <std::size_t... Is>
+    static constexpr auto filled(const V& v, std::index_sequence<Is...>)
+        -> std::array<V, M>
+    {
+        return {(static_cast<void>(Is), v)...};
+    }
+
+    [[nodiscard]] constexpr auto slot(std::size_t i) const -> std::size_t
+    {
+        return (first_ + i) % M;
+    }
+
+  public:
+    /// `zero` has the dimension of the stored vectors
+    constexpr explicit lbfgs_history(const V& zero)
+        : s_{filled(zero, std::make_index_sequence<M>{})},
+          y_{filled(zero, std::make_index_sequence<M>{})}
+    {}
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t { return size_; }
+
+    constexpr auto clear() -> void
+    {
+        first_ = 0;
+        size_ = 0;
+    }
+
+    /// Adds the pair for the step from `x` to `x1`, with gradients `g` and
+    /// `g1`
+    ///
+    /// Pairs without positive curvature are skipped, keeping the implicit
+    /// inverse Hessian positive definite, and leave the stored pairs as they
+    /// are.
+    template <Point P>
+        requires std::same_as<V, distance_t<P>>
+    constexpr auto push(const P& x, const P& x1, const V& g, const V& g1)
+        -> void
+    {
+        const auto ds = lazy(x1) - lazy(x);
+        const auto dg = lazy(g1) - lazy(g);
+
+        // Checked before a slot is overwritten
+        auto sy = scalar_type{};
+        for (std::size_t k{0}; k < ds.size(); ++k) {
+            sy += ds[k] * dg[k];
+        }
+        if (not(sy > scalar_type{})) {
+            return;
+        }
+
+        const auto i = size_ < M ? slot(size_) : first_;
+        assign(s_[i], ds);
+        assign(y_[i], dg);
+
+        rho_[i] = scalar_type{1} / sy;
+        if (size_ < M) {
+            ++size_;
+        } else {
+            first_ = slot(1);
+        }
+    }
+
+    /// Writes the quasi-Newton direction `-H g` into `d` with the two-loop
+    /// recursion
+    constexpr auto direction(const V& g, V& d) -> void
+    {
+        assign(d, scalar_type{-1} * lazy(g));
+
+        for (auto k = size_; k-- > 0;) {
+            const auto i = slot(k);
+            a_[i] = rho_[i] * dot(s_[i], d);
+            assign(d, lazy(d) + (-a_[i]) * lazy(y_[i]));
+        }
+
+        if (size_ > 0) {
+            const auto i = slot(size_ - 1);
+            const auto gamma = scalar_type{1} / (rho_[i] * dot(y_[i], y_[i]));
+            assign(d, gamma * lazy(d));
+        }
+
+        for (std::size_t k{0}; k < size_; ++k) {
+            const auto i = slot(k);
+            const auto b = rho_[i] * dot(y_[i], d);
+            assign(d, lazy(d) + (a_[i] - b) * lazy(s_[i]));
+        }
+    }
+};
+
+/// State of the limited memory BFGS method on `cost`, advanced one
+/// iteration at a time
+///
+/// The history and the search direction are allocated on construction. If
+/// a step along the quasi-Newton direction fails, the history is discarded
+/// and the next step follows the steepest descent.
+template <std::size_t M, class S, Point P, Cost<P> F>
+    requires(M > 0) && LineSearch<S, line_function<P, F>>
+class lbfgs_solver {
+    using scalar_type = scalar_t<P>;
+
+    F cost_;
+    solve_result<P> r_;
+    lbfgs_history<distance_t<P>, M> history_;
+    distance_t<P> d_;
+
+    scalar_type decrease_{};
+    scalar_type step_length_{};
+    bool moved_{true};
+
+    static constexpr auto start(P x, const F& cost, scalar_type value)
+        -> solve_result<P>
+    {
+        auto r = solve_result<P>{};
+        r.value = value;
+        r.gradient = opt::gradient(x, cost);
+        r.x = std::move(x);
+        r.cost_evaluations = 1;
+        r.gradient_evaluations = 1;
+        return r;
+    }
+
+    static constexpr auto start(P x, const F& cost) -> solve_result<P>
+    {
+        const auto value = cost(x);
+        return start(std::move(x), cost, value);
+    }
+
+  public:
+    /// `value` is the cost at `x`, evaluated by the caller
+    constexpr lbfgs_solver(P x, F cost, scalar_type value)
+        : cost_{std::move(cost)},
+          r_{start(std::move(x), cost_, value)},
+          history_{r_.gradient},
+          d_{r_.gradient}
+    {}
+
+    constexpr lbfgs_solver(P x, F cost)
+        : cost_{std::move(cost)},
+          r_{start(std::move(x), cost_)},
+          history_{r_.gradient},
+          d_{r_.gradient}
+    {}
+
+    /// Current point, with the value, gradient and evaluation counts
+    [[nodiscard]] constexpr auto result() const -> const solve_result<P>&
+    {
+        return r_;
+    }
+
+    /// Ends the run for `reason`
+    [[nodiscard]] constexpr auto finish(stop_reason reason) &&
+        -> solve_result<P>
+    {
+        r_.reason = reason;
+        return std::move(r_);
+    }
+
+    /// Criterion of `stop` met after the last iteration, if any
+    [[nodiscard]] constexpr auto
+    stopped(const detail::stop_criteria<scalar_type>& stop) const
+        -> std::optional<stop_reason>
+    {
+        return stop(r_, decrease_, step_length_, moved_);
+    }
+
+    /// Performs one iteration, returns `false` if no step along the steepest
+    /// descent decreases the cost
+    constexpr auto step() -> bool
+    {
+        ++r_.iterations;
+        history_.direction(r_.gradient, d_);
+
+        auto s = line_search(r_.x, d_, cost_, r_.value, r_.gradient, S{});
+        r_.cost_evaluations += s.cost_evaluations;
+        r_.gradient_evaluations += s.gradient_evaluations;
+        moved_ = s.alpha > scalar_type{};
+        if (not moved_) {
+            if (history_.size() == 0) {
+                return false;
+            }
+            history_.clear();
+            return true;
+        }
+
+        decrease_ = r_.value - s.value;
+        step_length_ = s.alpha * stdx::sqrt(norm(d_));
+
+        history_.push(r_.x, s.x, r_.gradient, s.gradient);
+        r_.x = std::move(s.x);
+        r_.value = s.value;
+        r_.gradient = std::move(s.gradient);
+        return true;
+    }
+};
+
+}  // namespace impl
+
+/// Minimizes `cost` from `x` with the limited memory BFGS method, keeping
+/// the last `M` curvature pairs, until one of the criteria of `options` is
+/// met
+///
+/// The history and the search direction are allocated once, before the
+/// first iteration. Each step is chosen by the line search policy `S`. If a
+/// step along the quasi-Newton direction fails, the history is discarded
+/// and the next step follows the steepest descent.
+template <std::size_t M = 8, class S = more_thuente, Point P, Cost<P> F>
+    requires(M > 0) && LineSearch<S, line_function<P, F>>
+constexpr auto lbfgs(P x, F cost, solver_options<scalar_t<P>> options = {})
+    -> solve_result<P>
+{
+    const auto stop = detail::stop_criteria{options};
+    auto solver = impl::lbfgs_solver<M, S, P, F>{std::move(x), std::move(cost)};
+
+    for (;;) {
+        if (const auto reason = solver.stopped(stop)) {
+            return std::move(solver).finish(*reason);
+        }
+        if (not solver.step()) {
+            return std::move(solver).finish(stop_reason::line_search_failed);
+        }
+    }
+}
+
+}  // namespace opt
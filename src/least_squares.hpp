@@ -0,0 +1,333 @@
+#pragma once
+
+#include "src/concepts.hpp"
+#include "src/convopt.hpp"
+#include "src/line_search.hpp"
+#include "src/matrix.hpp"
+#include "src/matrix_ops.hpp"
+#include "src/schedule.hpp"
+#include "src/solver_options.hpp"
+#include "src/spaces.hpp"
+#include "src/stdx/cmath.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace opt {
+
+/// Vector of residuals returned by `F` at points like `P`
+template <class F, Point P>
+using residuals_t = std::invoke_result_t<const F&, const P&>;
+
+/// Jacobian of the residuals of `F`, with a row per residual and a column
+/// per coordinate of `P`
+template <class F, Point P>
+using jacobian_t = matrix<residuals_t<F, P>, std::tuple_size_v<P>>;
+
+/// Residuals of `F` at a point like `P` and their Jacobian there
+template <class F, Point P>
+struct jacobian_result {
+    residuals_t<F, P> residuals{};
+    jacobian_t<F, P> jacobian{};
+    /// Evaluations of the residuals, all on dual points
+    std::size_t evaluations{};
+};
+
+/// Computes the Jacobian of `residuals` at `p`, one evaluation per column,
+/// along with the residuals
+///
+/// Column `j` is the first infinitesimal part of the residuals at the dual
+/// point seeded on coordinate `j`, and the residuals are the real part of
+/// the evaluation for the first column. The evaluations are run by the
+/// scheduler `s`.
+template <Point P, Residuals<P> F, Scheduler S = adaptive>
+constexpr auto jacobian(const P& p, F residuals, S s = {})
+    -> jacobian_result<F, P>
+{
+    constexpr auto M = std::tuple_size_v<residuals_t<F, P>>;
+    constexpr auto N = std::tuple_size_v<P>;
+
+    auto jr = jacobian_result<F, P>{};
+    auto set_columns = [&jr, &residuals, d = detail::as_point_dual(p)](
+                           std::size_t first, std::size_t last) {
+        auto dj = d;
+        for (auto j = first; j < last; ++j) {
+            dj[j].e1 = 1;
+            const auto r = residuals(dj);
+            dj[j].e1 = 0;
+
+            for (std::size_t i{0}; i < M; ++i) {
+                jr.jacobian[{i, j}] = r[i].e1;
+            }
+            if (j == 0) {
+                for (std::size_t i{0}; i < M; ++i) {
+                    jr.residuals[i] = r[i].real;
+                }
+            }
+        }
+    };
+
+    detail::schedule(s, N, set_columns);
+    jr.evaluations = N;
+    return jr;
+}
+
+/// Computes the Jacobian and the residuals with a single evaluation of
+/// `residuals`, seeding one infinitesimal component per coordinate
+template <Point P, VectorResiduals<P> F, Scheduler S = adaptive>
+constexpr auto jacobian(const P& p, F residuals, [[maybe_unused]] S s = {})
+    -> jacobian_result<F, P>
+{
+    constexpr auto M = std::tuple_size_v<residuals_t<F, P>>;
+    constexpr auto N = std::tuple_size_v<P>;
+
+    const auto r = residuals(detail::as_point_dual_vec(p));
+
+    auto jr = jacobian_result<F, P>{};
+    for (std::size_t i{0}; i < M; ++i) {
+        jr.residuals[i] = r[i].real;
+        for (std::size_t j{0}; j < N; ++j) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            jr.jacobian[{i, j}] = r[i].eps[j];
+        }
+    }
+    jr.evaluations = 1;
+    return jr;
+}
+
+/// Half the squared Euclidean norm of `residuals`, the cost minimized by the
+/// least-squares solvers
+///
+/// A `Cost` whenever `residuals` is, so any other solver applies too.
+template <class F>
+struct sum_of_squares {
+    F residuals;
+
+    template <Point Q>
+        requires std::regular_invocable<const F&, const Q&>
+    constexpr auto operator()(const Q& x) const -> scalar_t<Q>
+    {
+        const auto r = residuals(x);
+
+        auto acc = scalar_t<Q>{};
+        for (std::size_t i{0}; i < dimension(r); ++i) {
+            acc += r[i] * r[i];
+        }
+        return acc / scalar_t<Q>{2};
+    }
+};
+
+template <class F>
+sum_of_squares(F) -> sum_of_squares<F>;
+
+namespace detail {
+
+/// Normal equations `Jᵀ J` and `Jᵀ r` of a least-squares problem on points
+/// like `P`, the Hessian of the Gauss-Newton model and the gradient
+template <Point P>
+struct normal_equations {
+    matrix<distance_t<P>, std::tuple_size_v<P>> jtj{};
+    distance_t<P> jtr{};
+
+    template <class F>
+    constexpr explicit normal_equations(const jacobian_result<F, P>& jr)
+        : normal_equations{jr.jacobian, jr.residuals}
+    {}
+
+    template <class J, class R>
+    constexpr normal_equations(const J& jac, const R& r)
+    {
+        constexpr auto N = std::tuple_size_v<P>;
+
+        for (std::size_t j{0}; j < N; ++j) {
+            for (auto k = j; k < N; ++k) {
+                jtj[{j, k}] = dot(jac[j], jac[k]);
+                jtj[{k, j}] = jtj[{j, k}];
+            }
+            jtr[j] = dot(jac[j], r);
+        }
+    }
+};
+
+}  // namespace detail
+
+/// Minimizes half the sum of the squares of `residuals` from `x` with the
+/// Gauss-Newton method, choosing each step with the line search policy `S`,
+/// until one of the criteria of `options` is met
+///
+/// The step solves `Jᵀ J d = -Jᵀ r` with `modified_cholesky`, which only
+/// shifts `Jᵀ J` when `J` is rank deficient. Converges quickly when the
+/// residuals are small at the minimum. The residuals and the Jacobian come
+/// from a single call of `jacobian` per iteration. Ends with
+/// `stop_reason::factorization_failed` if `Jᵀ J` can't be factorized. The
+/// value and gradient of the result are those of
+/// `sum_of_squares{residuals}`, and each evaluation made by `jacobian`
+/// counts as a gradient evaluation.
+template <class S = more_thuente, Point P, Residuals<P> F>
+    requires LineSearch<S, line_function<P, sum_of_squares<F>>>
+constexpr auto gauss_newton(P x,
+                            F residuals,
+                            solver_options<scalar_t<P>> options = {})
+    -> solve_result<P>
+{
+    using T = scalar_t<P>;
+
+    const auto stop = detail::stop_criteria{options};
+
+    const auto cost = sum_of_squares<F>{residuals};
+
+    auto r = solve_result<P>{};
+    const auto jr = jacobian(x, residuals);
+    auto normal = detail::normal_equations<P>{jr};
+    r.value = norm(jr.residuals) / T{2};
+    r.gradient = normal.jtr;
+    r.x = std::move(x);
+    r.gradient_evaluations = jr.evaluations;
+
+    auto decrease = T{};
+    auto step_length = T{};
+    for (;;) {
+        if (const auto reason = stop(r, decrease, step_length)) {
+            r.reason = *reason;
+            break;
+        }
+
+        if (r.iterations > 0) {
+            const auto next = jacobian(r.x, residuals);
+            normal = detail::normal_equations<P>{next};
+            r.gradient_evaluations += next.evaluations;
+        }
+        if (not(modified_cholesky(normal.jtj) >= T{})) {
+            r.reason = stop_reason::factorization_failed;
+            break;
+        }
+        const auto d = -cholesky_solve(normal.jtj, normal.jtr);
+
+        auto step = line_search(r.x, d, cost, r.value, r.gradient, S{});
+        r.cost_evaluations += step.cost_evaluations;
+        r.gradient_evaluations += step.gradient_evaluations;
+        if (not(step.alpha > T{})) {
+            r.reason = stop_reason::line_search_failed;
+            break;
+        }
+
+        decrease = r.value - step.value;
+        step_length = step.alpha * stdx::sqrt(norm(d));
+
+        r.x = std::move(step.x);
+        r.value = step.value;
+        r.gradient = std::move(step.gradient);
+        ++r.iterations;
+    }
+
+    return r;
+}
+
+/// Minimizes half the sum of the squares of `residuals` from `x` with the
+/// Levenberg-Marquardt method, until one of the criteria of `options` is met
+///
+/// The step solves `(Jᵀ J + mu I) d = -Jᵀ r` with `cholesky`. The damping
+/// `mu` starts from `1e-3` times the largest diagonal entry of `Jᵀ J`, and is
+/// lowered after steps reducing the cost as well as predicted by the
+/// Gauss-Newton model and raised after failed steps, so that the method
+/// moves from gradient descent far from the minimum to Gauss-Newton close
+/// to it. Each iteration evaluates the residuals once, and the Jacobian,
+/// with the residuals, only after successful steps. See Madsen, Nielsen and
+/// Tingleff, Methods for Non-Linear Least Squares Problems, algorithm 3.16.
+/// Ends with `stop_reason::factorization_failed` if `mu` overflows before
+/// `Jᵀ J + mu I` can be factorized.
+///
+/// The value and gradient of the result are those of
+/// `sum_of_squares{residuals}`, and each evaluation made by `jacobian`
+/// counts as a gradient evaluation.
+template <Point P, Residuals<P> F>
+constexpr auto levenberg_marquardt(P x,
+                                   F residuals,
+                                   solver_options<scalar_t<P>> options = {})
+    -> solve_result<P>
+{
+    using T = scalar_t<P>;
+    constexpr auto N = std::tuple_size_v<P>;
+
+    const auto stop = detail::stop_criteria{options};
+
+    auto r = solve_result<P>{};
+    const auto jr = jacobian(x, residuals);
+    auto normal = detail::normal_equations<P>{jr};
+    r.value = norm(jr.residuals) / T{2};
+    r.gradient = normal.jtr;
+    r.x = std::move(x);
+    r.gradient_evaluations = jr.evaluations;
+
+    auto mu = T{};
+    for (std::size_t j{0}; j < N; ++j) {
+        mu = std::max(mu, normal.jtj[{j, j}]);
+    }
+    mu *= T{1e-3F};
+    auto nu = T{2};
+
+    auto moved = true;
+    auto decrease = T{};
+    auto step_length = T{};
+    for (;;) {
+        if (const auto reason = stop(r, decrease, step_length, moved)) {
+            r.reason = *reason;
+            break;
+        }
+        if (not(mu < std::numeric_limits<T>::max())) {
+            r.reason = stop_reason::factorization_failed;
+            break;
+        }
+
+        ++r.iterations;
+        auto damped = normal.jtj;
+        for (std::size_t j{0}; j < N; ++j) {
+            damped[{j, j}] += mu;
+        }
+        moved = cholesky(damped);
+        if (not moved) {
+            mu *= nu;
+            nu *= T{2};
+            continue;
+        }
+
+        const auto d = -cholesky_solve(damped, r.gradient);
+        const auto trial = r.x + d;
+        const auto value = norm(residuals(trial)) / T{2};
+        ++r.cost_evaluations;
+
+        // Decrease predicted by the Gauss-Newton model
+        const auto predicted = T{0.5F} * (mu * norm(d) - dot(d, r.gradient));
+        const auto rho = (r.value - value) / predicted;
+
+        moved = rho > T{};
+        if (not moved) {
+            mu *= nu;
+            nu *= T{2};
+            continue;
+        }
+
+        const auto t = T{2} * rho - T{1};
+        mu *= std::max(T{1} / T{3}, T{1} - t * t * t);
+        nu = T{2};
+
+        decrease = r.value - value;
+        step_length = stdx::sqrt(norm(d));
+
+        const auto next = jacobian(trial, residuals);
+        normal = detail::normal_equations<P>{next};
+        r.x = trial;
+        r.value = value;
+        r.gradient = normal.jtr;
+        r.gradient_evaluations += next.evaluations;
+    }
+
+    return r;
+}
+
+}  // namespace opt
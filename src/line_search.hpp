@@ -0,0 +1,406 @@
+#pragma once
+
+#include "src/stdx/cmath.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+
+namespace opt {
+
+/// Value and slope of a cost restricted to a line, at step `alpha`
+template <class T>
+struct line_sample {
+    T alpha{};
+    T value{};
+    T slope{};
+};
+
+// clang-format off
+/// Restriction `phi(alpha) = cost(x + alpha * d)` of a cost to a line
+///
+/// `origin()` is the sample at `alpha = 0`, known before the search starts.
+/// `value` and `sample` evaluate the cost, and the gradient for the slope,
+/// at a trial step.
+template <class F>
+concept LineFunction =
+  std::floating_point<typename F::scalar_type> &&
+  requires(F& phi, const F& cphi, typename F::scalar_type alpha) {
+    { cphi.origin() } -> std::same_as<line_sample<typename F::scalar_type>>;
+    { phi.value(alpha) } -> std::same_as<typename F::scalar_type>;
+    { phi.sample(alpha) } -> std::same_as<line_sample<typename F::scalar_type>>;
+  };
+
+/// Policy searching a step along a descent direction, starting from the
+/// trial step `alpha`
+///
+/// Returns the accepted step, or zero if no step decreasing the cost was
+/// found.
+template <class S, class F>
+concept LineSearch =
+  LineFunction<F> &&
+  requires(const S& s, F& phi, typename F::scalar_type alpha) {
+    { s(phi, alpha) } -> std::same_as<typename F::scalar_type>;
+  };
+// clang-format on
+
+namespace detail {
+
+/// Minimizer of the cubic interpolating the values and slopes of `a` and `b`,
+/// the midpoint if it does not exist
+template <std::floating_point T>
+[[nodiscard]] constexpr auto
+cubic_minimizer(const line_sample<T>& a, const line_sample<T>& b) -> T
+{
+    const auto midpoint = (a.alpha + b.alpha) / 2;
+
+    const auto d1 =
+        a.slope + b.slope - 3 * (a.value - b.value) / (a.alpha - b.alpha);
+    const auto discriminant = d1 * d1 - a.slope * b.slope;
+    if (discriminant < T{}) {
+        return midpoint;
+    }
+    const auto d2 =
+        (b.alpha < a.alpha ? T{-1} : T{1}) * stdx::sqrt(discriminant);
+
+    const auto den = b.slope - a.slope + 2 * d2;
+    if (den == T{}) {
+        return midpoint;
+    }
+    return b.alpha - (b.alpha - a.alpha) * (b.slope + d2 - d1) / den;
+}
+
+}  // namespace detail
+
+/// Shrinks the step until the Armijo sufficient decrease condition holds
+///
+/// Only evaluates the cost, never the gradient.
+struct backtracking_armijo {
+    /// Fraction of the decrease predicted by the slope at the origin
+    float c1{1e-4F};
+    /// Factor applied to the step after each rejected trial
+    float contraction{0.5F};
+    std::size_t max_iterations{50};
+
+    template <LineFunction F>
+    constexpr auto operator()(F& phi, typename F::scalar_type alpha) const ->
+        typename F::scalar_type
+    {
+        using T = typename F::scalar_type;
+
+        const auto o = phi.origin();
+        for (std::size_t i{0}; i < max_iterations; ++i) {
+            if (phi.value(alpha) <= o.value + T{c1} * alpha * o.slope) {
+                return alpha;
+            }
+            alpha *= T{contraction};
+        }
+        return T{};
+    }
+};
+
+/// Finds a step satisfying the strong Wolfe conditions, expanding the step
+/// until a minimum is bracketed and then zooming in with safeguarded cubic
+/// interpolation
+///
+/// See Nocedal and Wright, Numerical Optimization, algorithms 3.5 and 3.6.
+struct strong_wolfe {
+    /// Sufficient decrease parameter
+    float c1{1e-4F};
+    /// Curvature parameter
+    float c2{0.9F};
+    /// Factor applied to the step while no minimum is bracketed
+    float expansion{2.0F};
+    std::size_t max_iterations{50};
+
+    template <LineFunction F>
+    constexpr auto operator()(F& phi, typename F::scalar_type alpha) const ->
+        typename F::scalar_type
+    {
+        using T = typename F::scalar_type;
+        using S = line_sample<T>;
+
+        const auto o = phi.origin();
+        const auto armijo = [&o, c = T{c1}](const S& s) {
+            return s.value <= o.value + c * s.alpha * o.slope;
+        };
+        const auto curvature = [&o, c = T{c2}](const S& s) {
+            return stdx::abs(s.slope) <= -c * o.slope;
+        };
+
+        // `lo` satisfies the sufficient decrease condition and has the lowest
+        // value found, a minimum lies between `lo` and `hi`
+        const auto zoom = [&](S lo, S hi) {
+            for (std::size_t i{0}; i < max_iterations; ++i) {
+                const auto a = std::min(lo.alpha, hi.alpha);
+                const auto b = std::max(lo.alpha, hi.alpha);
+                const auto margin = (b - a) / 10;
+
+                auto trial = detail::cubic_minimizer(lo, hi);
+                if (not(a + margin < trial and trial < b - margin)) {
+                    trial = (lo.alpha + hi.alpha) / 2;
+                }
+                if (not(a < trial and trial < b)) {
+                    break;
+                }
+
+                const auto s = phi.sample(trial);
+                if (not armijo(s) or s.value >= lo.value) {
+                    hi = s;
+                } else {
+                    if (curvature(s)) {
+                        return s.alpha;
+                    }
+                    if (s.slope * (hi.alpha - lo.alpha) >= T{}) {
+                        hi = lo;
+                    }
+                    lo = s;
+                }
+            }
+            return lo.alpha;
+        };
+
+        auto prev = o;
+        for (std::size_t i{0}; i < max_iterations; ++i) {
+            const auto s = phi.sample(alpha);
+            if (not armijo(s) or (i > 0 and s.value >= prev.value)) {
+                return zoom(prev, s);
+            }
+            if (curvature(s)) {
+                return s.alpha;
+            }
+            if (s.slope >= T{}) {
+                return zoom(s, prev);
+            }
+            prev = s;
+            alpha *= T{expansion};
+        }
+        return prev.alpha;
+    }
+};
+
+/// Moré-Thuente line search, finding a step satisfying the strong Wolfe
+/// conditions within an interval of uncertainty that shrinks at every
+/// iteration
+///
+/// See Moré and Thuente, Line search algorithms with guaranteed sufficient
+/// decrease, ACM TOMS 20(3), 1994. Follows `dcsrch` and `dcstep` from
+/// MINPACK-2.
+struct more_thuente {
+    /// Sufficient decrease parameter
+    float ftol{1e-4F};
+    /// Curvature parameter
+    float gtol{0.9F};
+    /// Relative width of the interval of uncertainty at which the search
+    /// stops
+    float xtol{1e-6F};
+    float min_step{0.0F};
+    float max_step{1e10F};
+    std::size_t max_iterations{20};
+
+    template <LineFunction F>
+    constexpr auto operator()(F& phi, typename F::scalar_type alpha) const ->
+        typename F::scalar_type
+    {
+        using T = typename F::scalar_type;
+        using S = line_sample<T>;
+
+        const auto o = phi.origin();
+        if (not(o.slope < T{})) {
+            return T{};
+        }
+
+        constexpr auto extrapolate_lower = T{1.1F};
+        constexpr auto extrapolate_upper = T{4};
+
+        const auto step_lo = T{min_step};
+        const auto step_hi = T{max_step};
+        const auto gtest = T{ftol} * o.slope;
+
+        // Modified function psi(alpha) = phi(alpha) - gtest * alpha, used
+        // until a step with nonpositive psi and nonnegative phi' is found
+        const auto shift = [gtest](S s) {
+            s.value -= s.alpha * gtest;
+            s.slope -= gtest;
+            return s;
+        };
+        const auto unshift = [gtest](S s) {
+            s.value += s.alpha * gtest;
+            s.slope += gtest;
+            return s;
+        };
+
+        auto bracketed = false;
+        auto modified = true;
+        auto width = step_hi - step_lo;
+        auto width_prev = 2 * width;
+
+        // Best step `x` and other end `y` of the interval of uncertainty
+        auto x = o;
+        auto y = o;
+        auto lo = T{};
+        auto hi = alpha + extrapolate_upper * alpha;
+
+        for (std::size_t i{0}; i < max_iterations; ++i) {
+            const auto s = phi.sample(alpha);
+            const auto ftest = o.value + alpha * gtest;
+
+            if (modified and s.value <= ftest and
+                s.slope >= std::min(T{ftol}, T{gtol}) * o.slope) {
+                modified = false;
+            }
+
+            if (s.value <= ftest and
+                stdx::abs(s.slope) <= T{gtol} * -o.slope) {
+                return alpha;
+            }
+            if (bracketed and (alpha <= lo or alpha >= hi or
+                               hi - lo <= T{xtol} * hi)) {
+                break;
+            }
+            if (alpha == step_hi and s.value <= ftest and s.slope <= gtest) {
+                return alpha;
+            }
+            if (alpha == step_lo and (s.value > ftest or s.slope >= gtest)) {
+                break;
+            }
+
+            if (modified and s.value <= x.value and s.value > ftest) {
+                auto xm = shift(x);
+                auto ym = shift(y);
+                alpha = step(xm, ym, shift(s), bracketed, lo, hi);
+                x = unshift(xm);
+                y = unshift(ym);
+            } else {
+                alpha = step(x, y, s, bracketed, lo, hi);
+            }
+
+            if (bracketed) {
+                // Bisect if the interval did not shrink enough
+                if (stdx::abs(y.alpha - x.alpha) >= T{0.66F} * width_prev) {
+                    alpha = x.alpha + (y.alpha - x.alpha) / 2;
+                }
+                width_prev = width;
+                width = stdx::abs(y.alpha - x.alpha);
+
+                lo = std::min(x.alpha, y.alpha);
+                hi = std::max(x.alpha, y.alpha);
+            } else {
+                lo = alpha + extrapolate_lower * (alpha - x.alpha);
+                hi = alpha + extrapolate_upper * (alpha - x.alpha);
+            }
+
+            alpha = std::clamp(alpha, step_lo, step_hi);
+            if (bracketed and
+                (alpha <= lo or alpha >= hi or hi - lo <= T{xtol} * hi)) {
+                alpha = x.alpha;
+            }
+        }
+        return x.alpha;
+    }
+
+  private:
+    /// Updates the interval of uncertainty `[x, y]` with the trial `t` and
+    /// returns the next trial step, kept within `[lo, hi]` until a minimum is
+    /// bracketed
+    template <std::floating_point T>
+    static constexpr auto step(line_sample<T>& x,
+                               line_sample<T>& y,
+                               const line_sample<T>& t,
+                               bool& bracketed,
+                               T lo,
+                               T hi) -> T
+    {
+        using stdx::abs;
+
+        // Minimizer of the cubic interpolating `a` and `t`
+        const auto cubic = [&t](const line_sample<T>& a) {
+            const auto theta =
+                3 * (a.value - t.value) / (t.alpha - a.alpha) + a.slope +
+                t.slope;
+            const auto s =
+                std::max({abs(theta), abs(a.slope), abs(t.slope)});
+            const auto d =
+                (theta / s) * (theta / s) - (a.slope / s) * (t.slope / s);
+            auto gamma = s * stdx::sqrt(std::max(d, T{}));
+            if (t.alpha > a.alpha) {
+                gamma = -gamma;
+            }
+            return std::pair{theta, gamma};
+        };
+
+        const auto sign = x.slope < T{} ? -t.slope : t.slope;
+        auto next = T{};
+
+        if (t.value > x.value) {
+            // Higher value, the minimum is bracketed
+            auto [theta, gamma] = cubic(x);
+            gamma = -gamma;
+            const auto p = (gamma - x.slope) + theta;
+            const auto q = ((gamma - x.slope) + gamma) + t.slope;
+            const auto stpc = x.alpha + p / q * (t.alpha - x.alpha);
+            const auto stpq =
+                x.alpha +
+                x.slope / ((x.value - t.value) / (t.alpha - x.alpha) + x.slope) /
+                    2 * (t.alpha - x.alpha);
+            next = abs(stpc - x.alpha) < abs(stpq - x.alpha)
+                       ? stpc
+                       : stpc + (stpq - stpc) / 2;
+            bracketed = true;
+        } else if (sign < T{}) {
+            // Slopes of opposite sign, the minimum is bracketed
+            const auto [theta, gamma] = cubic(x);
+            const auto p = (gamma - t.slope) + theta;
+            const auto q = ((gamma - t.slope) + gamma) + x.slope;
+            const auto stpc = t.alpha + p / q * (x.alpha - t.alpha);
+            const auto stpq =
+                t.alpha + t.slope / (t.slope - x.slope) * (x.alpha - t.alpha);
+            next = abs(stpc - t.alpha) > abs(stpq - t.alpha) ? stpc : stpq;
+            bracketed = true;
+        } else if (abs(t.slope) < abs(x.slope)) {
+            // Same sign, decreasing magnitude of the slope
+            const auto [theta, gamma] = cubic(x);
+            const auto p = (gamma - t.slope) + theta;
+            const auto q = (gamma + (x.slope - t.slope)) + gamma;
+            const auto r = p / q;
+
+            auto stpc = t.alpha > x.alpha ? hi : lo;
+            if (r < T{} and gamma != T{}) {
+                stpc = t.alpha + r * (x.alpha - t.alpha);
+            }
+            const auto stpq =
+                t.alpha + t.slope / (t.slope - x.slope) * (x.alpha - t.alpha);
+
+            if (bracketed) {
+                next = abs(stpc - t.alpha) < abs(stpq - t.alpha) ? stpc : stpq;
+                const auto limit = t.alpha + T{0.66F} * (y.alpha - t.alpha);
+                next = t.alpha > x.alpha ? std::min(limit, next)
+                                         : std::max(limit, next);
+            } else {
+                next = abs(stpc - t.alpha) > abs(stpq - t.alpha) ? stpc : stpq;
+                next = std::clamp(next, lo, hi);
+            }
+        } else if (bracketed) {
+            // Same sign, nondecreasing magnitude of the slope
+            const auto [theta, gamma] = cubic(y);
+            const auto p = (gamma - t.slope) + theta;
+            const auto q = ((gamma - t.slope) + gamma) + y.slope;
+            next = t.alpha + p / q * (y.alpha - t.alpha);
+        } else {
+            next = t.alpha > x.alpha ? hi : lo;
+        }
+
+        if (t.value > x.value) {
+            y = t;
+        } else {
+            if (sign < T{}) {
+                y = x;
+            }
+            x = t;
+        }
+        return next;
+    }
+};
+
+}  // namespace opt
@@ -3,59 +3,247 @@
 #include "concepts.hpp"
 #include "dualnumbers.hpp"
 #include "impl/base_fn.hpp"
-#include "impl/series.hpp"
+#include "impl/transcendental.hpp"
+#include "reverse.hpp"
+#include "sparsity_tracer.hpp"
+#include "stdx/cmath.hpp"
+#include "taylor.hpp"
 
 #include <cmath>
 #include <cstddef>
 #include <iostream>
+#include <limits>
+#include <ranges>
 #include <type_traits>
+#include <utility>
 
 namespace opt {
 namespace impl {
 
-template <std::size_t N>
-inline constexpr auto exp_ = make_base_fn_<N>([]<Real T>(T x) -> T {
-    return series::sum_first<N>(series::geometric{
-        1U,    //
-        T{1},  //
-        [x](auto n) { return x / T(n); }});
-});
-
-template <std::size_t N>
-inline constexpr auto sin_ = make_base_fn_<N>([]<Real T>(T x) -> T {
-    return series::sum_first<N>(series::geometric{
-        1U,  //
-        x,   //
-        [x](auto i) {
-            const auto n = T(i);
-            return (-1) * (x * x) / (2 * n) / (2 * n + 1);
-        }});
-});
-
-template <std::size_t N>
-inline constexpr auto cos_ = make_base_fn_<N>([]<Real T>(T x) -> T {
-    return series::sum_first<N>(series::geometric{
-        1U,    //
-        T{1},  //
-        [x](auto i) {
-            const auto n = T(i);
-            return (-1) * (x * x) / (2 * n - 1) / (2 * n);
-        }});
-});
+namespace tr = transcendental;
 
+inline constexpr auto exp_ =
+    base_fn{[]<tr::Supported T>(T x) -> T { return tr::exp(x); }};
+inline constexpr auto log_ =
+    base_fn{[]<tr::Supported T>(T x) -> T { return tr::log(x); }};
+inline constexpr auto sin_ =
+    base_fn{[]<tr::Supported T>(T x) -> T { return tr::sin(x); }};
+inline constexpr auto cos_ =
+    base_fn{[]<tr::Supported T>(T x) -> T { return tr::cos(x); }};
+inline constexpr auto tan_ =
+    base_fn{[]<tr::Supported T>(T x) -> T { return tr::tan(x); }};
+inline constexpr auto sqrt_ =
+    base_fn{[]<tr::Supported T>(T x) -> T { return tr::sqrt(x); }};
+inline constexpr auto tanh_ =
+    base_fn{[]<tr::Supported T>(T x) -> T { return tr::tanh(x); }};
+inline constexpr auto log1p_ =
+    base_fn{[]<tr::Supported T>(T x) -> T { return tr::log1p(x); }};
+
+// Derivatives of the functions above, in terms of the function values when
+// that saves an evaluation
+
+inline constexpr auto reciprocal = []<tr::Supported T>(T x) -> T {
+    return T{1} / x;
+};
+inline constexpr auto reciprocal_d = []<tr::Supported T>(T x) -> T {
+    return T{-1} / (x * x);
+};
+inline constexpr auto tan_d = []<tr::Supported T>(T x) -> T {
+    const auto t = tr::tan(x);
+    return T{1} + t * t;
+};
+inline constexpr auto tan_d2 = []<tr::Supported T>(T x) -> T {
+    const auto t = tr::tan(x);
+    return T{2} * t * (T{1} + t * t);
+};
+inline constexpr auto sqrt_d = []<tr::Supported T>(T x) -> T {
+    return T{0.5F} / tr::sqrt(x);
+};
+inline constexpr auto sqrt_d2 = []<tr::Supported T>(T x) -> T {
+    return T{-0.25F} / (x * tr::sqrt(x));
+};
+inline constexpr auto tanh_d = []<tr::Supported T>(T x) -> T {
+    const auto t = tr::tanh(x);
+    return T{1} - t * t;
+};
+inline constexpr auto tanh_d2 = []<tr::Supported T>(T x) -> T {
+    const auto t = tr::tanh(x);
+    return T{-2} * t * (T{1} - t * t);
+};
+inline constexpr auto log1p_d = []<tr::Supported T>(T x) -> T {
+    return T{1} / (T{1} + x);
+};
+inline constexpr auto log1p_d2 = []<tr::Supported T>(T x) -> T {
+    return T{-1} / ((T{1} + x) * (T{1} + x));
+};
+
+inline constexpr auto sigmoid_ = []<tr::Supported T>(T x) -> T {
+    // exp is only evaluated at non positive arguments, where it can't
+    // overflow
+    const auto e = tr::exp(-stdx::abs(x));
+    const auto s = T{1} / (T{1} + e);
+    return x < T{} ? e * s : s;
+};
+inline constexpr auto sigmoid_d = []<tr::Supported T>(T x) -> T {
+    const auto s = sigmoid_(x);
+    return s * (T{1} - s);
+};
+inline constexpr auto sigmoid_d2 = []<tr::Supported T>(T x) -> T {
+    const auto s = sigmoid_(x);
+    return s * (T{1} - s) * (T{1} - T{2} * s);
+};
+inline constexpr auto softplus_ = []<tr::Supported T>(T x) -> T {
+    return (x < T{} ? T{} : x) + tr::log1p(tr::exp(-stdx::abs(x)));
+};
+
+/// Real part of a number, the number itself for real numbers
+template <class T>
+constexpr auto primal(const T& x)
+{
+    if constexpr (Adjoint<T>) {
+        return x.value;
+    } else if constexpr (Taylor<T>) {
+        return x.coefficients[0];
+    } else if constexpr (Real<T>) {
+        return x;
+    } else {
+        return x.real;
+    }
+}
+
+template <class T>
+using primal_t = decltype(primal(std::declval<const T&>()));
+
+/// Applies a function with value `f`, derivative `g` and second derivative
+/// `h` at the real part of `x`
+template <Dual T>
+constexpr auto chain(const T& x, primal_t<T> f, primal_t<T> g, primal_t<T> h)
+    -> T
+{
+    return {f, x.e1 * g, x.e2 * g, x.e3 * g + x.e1 * x.e2 * h};
+}
+template <DualVec T>
+constexpr auto chain(const T& x, primal_t<T> f, primal_t<T> g) -> T
+{
+    auto r = T{f};
+    for (std::size_t i{0}; i < x.eps.size(); ++i) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        r.eps[i] = x.eps[i] * g;
+    }
+    return r;
+}
+template <DualVec T>
+constexpr auto chain(const T& x, primal_t<T> f, primal_t<T> g, primal_t<T>)
+    -> T
+{
+    return chain(x, f, g);
+}
+template <HyperDualVec T>
+constexpr auto chain(const T& x, primal_t<T> f, primal_t<T> g, primal_t<T> h)
+    -> T
+{
+    auto r = T{f, x.e1 * g};
+    for (std::size_t j{0}; j < x.e2.size(); ++j) {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+        r.e2[j] = x.e2[j] * g;
+        r.e3[j] = x.e3[j] * g + x.e1 * x.e2[j] * h;
+        // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+    return r;
+}
+template <DualLanes T>
+constexpr auto chain(const T& x, primal_t<T> f, primal_t<T> g, primal_t<T> h)
+    -> T
+{
+    auto r = T{f};
+    for (std::size_t k{0}; k < T::width; ++k) {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+        r.e1[k] = x.e1[k] * g;
+        r.e2[k] = x.e2[k] * g;
+        r.e3[k] = x.e3[k] * g + x.e1[k] * x.e2[k] * h;
+        // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+    return r;
+}
+template <Adjoint T>
+auto chain(const T& x, primal_t<T> f, primal_t<T> g) -> T
+{
+    return x.chain(f, g);
+}
+template <Adjoint T>
+auto chain(const T& x, primal_t<T> f, primal_t<T> g, primal_t<T>) -> T
+{
+    return x.chain(f, g);
+}
+/// Only the value is needed for sparsity patterns
+template <SparsityTracer T>
+constexpr auto chain(const T& x, primal_t<T> f) -> T
+{
+    return T::nonlinear(x, f);
+}
+template <SparsityTracer T>
+constexpr auto chain(const T& x, primal_t<T> f, primal_t<T>, primal_t<T>)
+    -> T
+{
+    return T::nonlinear(x, f);
+}
+
+/// Stands for the missing series of a `dual_fn`, which then doesn't accept
+/// `taylor` arguments
+struct no_series {};
+
+// Series of the functions above for `taylor` arguments
+
+inline constexpr auto exp_series_ = []<Taylor T>(const T& x) -> T {
+    return exp_series(x, exp_(primal(x)));
+};
+inline constexpr auto log_series_ = []<Taylor T>(const T& x) -> T {
+    return log_series(x, log_(primal(x)));
+};
+inline constexpr auto sin_series_ = []<Taylor T>(const T& x) -> T {
+    return sin_cos_series(x, sin_(primal(x)), cos_(primal(x))).first;
+};
+inline constexpr auto cos_series_ = []<Taylor T>(const T& x) -> T {
+    return sin_cos_series(x, sin_(primal(x)), cos_(primal(x))).second;
+};
+inline constexpr auto sqrt_series_ = []<Taylor T>(const T& x) -> T {
+    return pow_series(x, primal_t<T>{0.5F}, sqrt_(primal(x)));
+};
+
+/// Function of real and dual numbers, given by its value `F` and its first
+/// and second derivatives `G` and `H`, and for `taylor` numbers by the series
+/// `E`
 template <std::default_initializable F,
           std::default_initializable G,
-          std::default_initializable H>
+          std::default_initializable H,
+          std::default_initializable E = no_series>
 struct dual_fn {
     constexpr dual_fn(F, G, H) noexcept {}
+    constexpr dual_fn(F, G, H, E) noexcept {}
 
-    template <Dual T>
+    template <class T>
+        requires Dual<T> or HyperDualVec<T> or DualLanes<T>
     constexpr auto operator()(const T& x) const -> T
     {
-        return {F{}(x.real),
-                x.e1 * G{}(x.real),
-                x.e2 * G{}(x.real),
-                x.e3 * G{}(x.real) + x.e1 * x.e2 * H{}(x.real)};
+        return chain(x, F{}(x.real), G{}(x.real), H{}(x.real));
+    }
+    /// Types without second order parts don't evaluate `H`
+    template <class T>
+        requires DualVec<T> or Adjoint<T>
+    constexpr auto operator()(const T& x) const -> T
+    {
+        return chain(x, F{}(primal(x)), G{}(primal(x)));
+    }
+    template <SparsityTracer T>
+    constexpr auto operator()(const T& x) const -> T
+    {
+        return chain(x, F{}(x.real));
+    }
+    template <Taylor T>
+        requires std::invocable<const E&, const T&>
+    constexpr auto operator()(const T& x) const -> T
+    {
+        return E{}(x);
     }
     template <Real T>
     constexpr auto operator()(T x) const -> T
@@ -66,20 +254,151 @@ struct dual_fn {
 
 }  // namespace impl
 
-template <std::size_t N>
-inline constexpr impl::dual_fn exp_{
-    impl::exp_<N>, impl::exp_<N>, impl::exp_<N>};
+/// Elementary functions of real numbers and of the dual number types
+///
+/// For `float` and `double`, the functions are usable in constant expressions
+/// and give the same results during constant evaluation and at run time,
+/// except as noted in `impl::transcendental`.
+///
+/// `exp`, `log`, `sin`, `cos` and `sqrt` also accept `taylor` numbers.
+inline constexpr impl::dual_fn exp{
+    impl::exp_, impl::exp_, impl::exp_, impl::exp_series_};
+inline constexpr impl::dual_fn log{
+    impl::log_, impl::reciprocal, impl::reciprocal_d, impl::log_series_};
+inline constexpr impl::dual_fn sin{
+    impl::sin_, impl::cos_, -impl::sin_, impl::sin_series_};
+inline constexpr impl::dual_fn cos{
+    impl::cos_, -impl::sin_, -impl::cos_, impl::cos_series_};
+inline constexpr impl::dual_fn tan{impl::tan_, impl::tan_d, impl::tan_d2};
+inline constexpr impl::dual_fn sqrt{
+    impl::sqrt_, impl::sqrt_d, impl::sqrt_d2, impl::sqrt_series_};
+inline constexpr impl::dual_fn tanh{impl::tanh_, impl::tanh_d, impl::tanh_d2};
+inline constexpr impl::dual_fn log1p{
+    impl::log1p_, impl::log1p_d, impl::log1p_d2};
+
+/// Logistic function `1 / (1 + exp(-x))`
+inline constexpr impl::dual_fn sigmoid{
+    impl::sigmoid_, impl::sigmoid_d, impl::sigmoid_d2};
+/// `log(1 + exp(x))`, without overflow for large `x`
+inline constexpr impl::dual_fn softplus{
+    impl::softplus_, impl::sigmoid_, impl::sigmoid_d};
+
+namespace impl {
+
+struct pow_fn {
+    template <transcendental::Supported T>
+    constexpr auto operator()(T x, T y) const -> T
+    {
+        return transcendental::pow(x, y);
+    }
+    /// `x` raised to a real exponent, defined for all `x` where the real
+    /// power is, except `x = 0` for `taylor` numbers
+    ///
+    /// A derivative with a zero coefficient, as the second one for `y = 1`,
+    /// is zero rather than `0 * pow(0, y - 2)`, which is NaN at `x = 0`.
+    template <class T>
+        requires(not Real<T>)
+    constexpr auto operator()(const T& x, primal_t<T> y) const -> T
+    {
+        using S = primal_t<T>;
+        const auto p = primal(x);
+        if constexpr (Taylor<T>) {
+            return pow_series(x, y, transcendental::pow(p, y));
+        } else {
+            const auto term = [p](S c, S e) {
+                return c == S{} ? S{} : c * transcendental::pow(p, e);
+            };
+            return chain(x,
+                         transcendental::pow(p, y),
+                         term(y, y - S{1}),
+                         term(y * (y - S{1}), y - S{2}));
+        }
+    }
+    /// A positive real raised to `y`
+    template <class T>
+        requires(not Real<T>)
+    constexpr auto operator()(primal_t<T> x, const T& y) const -> T
+    {
+        const auto l = transcendental::log(x);
+        if constexpr (Taylor<T>) {
+            return opt::exp(y * T{l});
+        } else {
+            const auto f = transcendental::pow(x, primal(y));
+            return chain(y, f, f * l, f * l * l);
+        }
+    }
+    /// `exp(y log(x))`, defined for positive `x`
+    template <class T>
+        requires(not Real<T>)
+    constexpr auto operator()(const T& x, const T& y) const -> T
+    {
+        return opt::exp(y * opt::log(x));
+    }
+};
+
+/// The derivative at zero is taken as that of `x`
+struct abs_fn {
+    template <class T>
+    constexpr auto operator()(const T& x) const -> T
+    {
+        return x < T{} ? -x : x;
+    }
+};
+
+/// Returns `x` on ties, with its derivatives
+struct min_fn {
+    template <class T>
+    constexpr auto operator()(const T& x, const T& y) const -> T
+    {
+        return y < x ? y : x;
+    }
+};
+
+/// Returns `x` on ties, with its derivatives
+struct max_fn {
+    template <class T>
+    constexpr auto operator()(const T& x, const T& y) const -> T
+    {
+        return x < y ? y : x;
+    }
+};
+
+}  // namespace impl
+
+/// `x` raised to `y`
+inline constexpr impl::pow_fn pow{};
 
-template <std::size_t N>
-inline constexpr impl::dual_fn sin_{
-    impl::sin_<N>, impl::cos_<N>, -impl::sin_<N>};
+inline constexpr impl::abs_fn abs{};
+inline constexpr impl::min_fn min{};
+inline constexpr impl::max_fn max{};
 
-template <std::size_t N>
-inline constexpr impl::dual_fn cos_{
-    impl::cos_<N>, -impl::sin_<N>, -impl::cos_<N>};
+/// `log(sum(exp(x)))` over the elements `x` of `xs`
+///
+/// Computed in a single pass, relative to the largest element seen so far so
+/// that no exponential overflows. Gives negative infinity for empty ranges.
+template <std::ranges::input_range R>
+constexpr auto log_sum_exp(R&& xs) -> std::ranges::range_value_t<R>
+{
+    using T = std::ranges::range_value_t<R>;
+    using S = impl::primal_t<T>;
 
-inline constexpr auto exp = exp_<10>;
-inline constexpr auto sin = sin_<10>;
-inline constexpr auto cos = cos_<10>;
+    const auto lowest = T{-std::numeric_limits<S>::infinity()};
+
+    auto m = lowest;
+    auto s = T{};
+    for (const auto& x : xs) {
+        // Elements equal to negative infinity add nothing
+        if (impl::primal(x) == impl::primal(lowest)) {
+            continue;
+        }
+        if (m < x) {
+            s = s * opt::exp(m - x) + T{S{1}};
+            m = x;
+        } else {
+            s += opt::exp(x - m);
+        }
+    }
+    return impl::primal(s) == S{} ? m : m + opt::log(s);
+}
 
 }  // namespace opt
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "impl/gemm.hpp"
 #include "spaces.hpp"
 #include "spaces_ops.hpp"
 
@@ -140,6 +141,8 @@ struct matrix {
     [[nodiscard]] friend constexpr auto
     operator==(const matrix& lhs, const matrix& rhs) -> bool = default;
 
+    // At runtime, products of larger `float` and `double` matrices use the
+    // blocked kernel in impl/gemm.hpp
     template <Vector W, std::size_t OtherCols>
     // clang-format off
     requires(W::size == Cols)
@@ -149,6 +152,20 @@ struct matrix {
     // clang-format oon
     {
         matrix<V, OtherCols> m2{};
+        if constexpr (detail::simd_contiguous<V> and
+                      std::same_as<entries_type, scalar_t<W>> and
+                      rows * OtherCols * Cols > impl::gemm::small_size) {
+            if (not std::is_constant_evaluated()) {
+                impl::gemm::multiply<entries_type>(
+                    rows,
+                    OtherCols,
+                    Cols,
+                    [&m0](std::size_t j) { return m0[j].data.data(); },
+                    [&m1](std::size_t j) { return m1[j].data.data(); },
+                    [&m2](std::size_t j) { return m2[j].data.data(); });
+                return m2;
+            }
+        }
         std::transform(
             m1.begin(), m1.end(), m2.begin(), [&m0](const W& m1_column) {
                 return m0 * m1_column;
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "matrix.hpp"
+#include "stdx/cmath.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
 
 namespace opt {
 
@@ -35,4 +40,166 @@ requires(matrix<V, Cols>::is_square)
     (std::make_index_sequence<Cols>{});
 }
 
-}  // namespace opt
\ No newline at end of file
+// Factorizations of symmetric matrices work in place on the lower triangle,
+// one column at a time so that the inner loops run over contiguous entries
+// of the column major storage. The upper triangle is neither read nor
+// written.
+
+/// Factorizes the symmetric positive definite `m` in place into `L Lᵀ`,
+/// storing `L` in the lower triangle
+///
+/// Returns `false`, leaving `m` partially factorized, if `m` is not
+/// positive definite.
+template <class V, std::size_t Cols>
+    requires(matrix<V, Cols>::is_square)
+[[nodiscard]] constexpr auto cholesky(matrix<V, Cols>& m) -> bool
+{
+    using T = scalar_t<V>;
+
+    for (std::size_t j{0}; j < Cols; ++j) {
+        auto& cj = m[j];
+        for (std::size_t k{0}; k < j; ++k) {
+            const auto& ck = m[k];
+            const auto ljk = ck[j];
+            for (auto i = j; i < Cols; ++i) {
+                cj[i] -= ck[i] * ljk;
+            }
+        }
+
+        if (not(cj[j] > T{})) {
+            return false;
+        }
+        cj[j] = stdx::sqrt(cj[j]);
+        for (auto i = j + 1; i < Cols; ++i) {
+            cj[i] /= cj[j];
+        }
+    }
+    return true;
+}
+
+/// Factorizes `m + tau I` in place with `cholesky`, for the smallest `tau`
+/// found making it positive definite, and returns `tau`
+///
+/// `tau` starts from zero if the diagonal of `m` is positive and doubles
+/// from `beta` times the largest diagonal entry otherwise. See Nocedal and
+/// Wright, Numerical Optimization, algorithm 3.3.
+///
+/// Returns NaN, leaving `m` unchanged, if the diagonal of `m` is not finite
+/// or no `tau` is found within `max_shifts` doublings, e.g. if `m` has NaN
+/// entries.
+template <class V, std::size_t Cols>
+    requires(matrix<V, Cols>::is_square)
+constexpr auto modified_cholesky(matrix<V, Cols>& m,
+                                 scalar_t<V> beta = scalar_t<V>{1e-3F},
+                                 std::size_t max_shifts = 64) -> scalar_t<V>
+{
+    using T = scalar_t<V>;
+
+    auto min_diagonal = m[{0, 0}];
+    auto max_diagonal = stdx::abs(m[{0, 0}]);
+    for (std::size_t i{1}; i < Cols; ++i) {
+        min_diagonal = std::min(min_diagonal, m[{i, i}]);
+        max_diagonal = std::max(max_diagonal, stdx::abs(m[{i, i}]));
+    }
+    for (std::size_t i{0}; i < Cols; ++i) {
+        if (not(stdx::abs(m[{i, i}]) <= std::numeric_limits<T>::max())) {
+            return std::numeric_limits<T>::quiet_NaN();
+        }
+    }
+
+    const auto shift = beta * std::max(max_diagonal, T{1});
+    auto tau = min_diagonal > T{} ? T{} : shift - min_diagonal;
+    for (std::size_t k{0};
+         k <= max_shifts and tau <= std::numeric_limits<T>::max();
+         ++k) {
+        auto shifted = m;
+        for (std::size_t i{0}; i < Cols; ++i) {
+            shifted[{i, i}] += tau;
+        }
+        if (cholesky(shifted)) {
+            m = shifted;
+            return tau;
+        }
+        tau = std::max(2 * tau, shift);
+    }
+    return std::numeric_limits<T>::quiet_NaN();
+}
+
+/// Factorizes the symmetric `m` in place into `L D Lᵀ`, storing the unit
+/// lower triangular `L` below the diagonal and `D` on the diagonal
+///
+/// Unlike `cholesky`, indefinite matrices are factorized as well. Returns
+/// `false` if a zero pivot is found.
+template <class V, std::size_t Cols>
+    requires(matrix<V, Cols>::is_square)
+[[nodiscard]] constexpr auto ldlt(matrix<V, Cols>& m) -> bool
+{
+    using T = scalar_t<V>;
+
+    for (std::size_t j{0}; j < Cols; ++j) {
+        auto& cj = m[j];
+        for (std::size_t k{0}; k < j; ++k) {
+            const auto& ck = m[k];
+            const auto w = ck[j] * ck[k];
+            for (auto i = j; i < Cols; ++i) {
+                cj[i] -= ck[i] * w;
+            }
+        }
+
+        if (cj[j] == T{}) {
+            return false;
+        }
+        for (auto i = j + 1; i < Cols; ++i) {
+            cj[i] /= cj[j];
+        }
+    }
+    return true;
+}
+
+/// Solves `L Lᵀ x = b` for the factor computed by `cholesky`
+template <class V, std::size_t Cols>
+    requires(matrix<V, Cols>::is_square)
+[[nodiscard]] constexpr auto cholesky_solve(const matrix<V, Cols>& l, V b)
+    -> V
+{
+    for (std::size_t j{0}; j < Cols; ++j) {
+        const auto& cj = l[j];
+        b[j] /= cj[j];
+        for (auto i = j + 1; i < Cols; ++i) {
+            b[i] -= cj[i] * b[j];
+        }
+    }
+    for (auto j = Cols; j-- > 0;) {
+        const auto& cj = l[j];
+        for (auto i = j + 1; i < Cols; ++i) {
+            b[j] -= cj[i] * b[i];
+        }
+        b[j] /= cj[j];
+    }
+    return b;
+}
+
+/// Solves `L D Lᵀ x = b` for the factors computed by `ldlt`
+template <class V, std::size_t Cols>
+    requires(matrix<V, Cols>::is_square)
+[[nodiscard]] constexpr auto ldlt_solve(const matrix<V, Cols>& ld, V b) -> V
+{
+    for (std::size_t j{0}; j < Cols; ++j) {
+        const auto& cj = ld[j];
+        for (auto i = j + 1; i < Cols; ++i) {
+            b[i] -= cj[i] * b[j];
+        }
+    }
+    for (std::size_t j{0}; j < Cols; ++j) {
+        b[j] /= ld[{j, j}];
+    }
+    for (auto j = Cols; j-- > 0;) {
+        const auto& cj = ld[j];
+        for (auto i = j + 1; i < Cols; ++i) {
+            b[j] -= cj[i] * b[i];
+        }
+    }
+    return b;
+}
+
+}  // namespace opt
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "src/concepts.hpp"
+#include "src/convopt.hpp"
+#include "src/lbfgs.hpp"
+#include "src/line_search.hpp"
+#include "src/solver_options.hpp"
+#include "src/spaces.hpp"
+#include "src/stdx/cmath.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace opt {
+
+/// Settings of `multistart_optimize`
+template <std::floating_point T>
+struct multistart_options {
+    /// Stopping criteria of each start, the time budget included
+    solver_options<T> solver{};
+
+    /// A start is abandoned once it has run `abandon_after` iterations with
+    /// a value above `incumbent + dominance_margin * (1 + |incumbent|)`,
+    /// where `incumbent` is the lowest value reached by any start so far
+    std::size_t abandon_after{10};
+    T dominance_margin{1};
+};
+
+/// Outcome of a single start of `multistart_optimize`
+template <Point P>
+struct start_result {
+    P x;
+    scalar_t<P> value{std::numeric_limits<scalar_t<P>>::infinity()};
+
+    std::size_t iterations{};
+    std::size_t cost_evaluations{};
+    std::size_t gradient_evaluations{};
+
+    bool converged{};
+    bool abandoned{};
+};
+
+/// Outcome of `multistart_optimize`
+template <Point P>
+struct multistart_result {
+    /// Lowest value found, and where
+    P x;
+    scalar_t<P> value{std::numeric_limits<scalar_t<P>>::infinity()};
+    /// Index of the start that found `x`
+    std::size_t best_start{};
+
+    /// One entry per start, in the order of the starting points
+    std::vector<start_result<P>> starts;
+};
+
+namespace detail {
+
+/// Lowers `a` to `x` if `x` is smaller
+template <std::floating_point T>
+auto fetch_min(std::atomic<T>& a, T x) -> void
+{
+    auto current = a.load(std::memory_order_relaxed);
+    while (x < current and
+           not a.compare_exchange_weak(current, x, std::memory_order_relaxed)) {
+    }
+}
+
+/// Values of the `BatchCost` `cost` at the points of `starts`, passed in
+/// batches of at most `max_batch_size`
+template <class R, class F, Point P = std::ranges::range_value_t<R>>
+auto batch_values(const R& starts, const F& cost) -> std::vector<scalar_t<P>>
+{
+    const auto n = static_cast<std::size_t>(std::ranges::size(starts));
+    auto values = std::vector<scalar_t<P>>(n);
+
+    auto points = std::vector<P>{};
+    for (std::size_t b{0}; b < n; b += max_batch_size) {
+        const auto m = std::min(max_batch_size, n - b);
+        const auto first =
+            std::ranges::begin(starts) + static_cast<std::ptrdiff_t>(b);
+        points.assign(first, first + static_cast<std::ptrdiff_t>(m));
+        cost(std::span<const P>{points},
+             std::span<scalar_t<P>>{values.data() + b, m});
+    }
+    return values;
+}
+
+}  // namespace detail
+
+/// Minimizes `cost` with `lbfgs` from each point of `starts`, running the
+/// starts concurrently according to the execution policy `policy`
+///
+/// Every iteration of every start publishes its value to a shared
+/// incumbent. As each step decreases the value, the incumbent bounds the
+/// final result from above, and starts far above it are abandoned as set by
+/// `options`. The returned result holds the best point over the starts that
+/// were not abandoned, ties going to the first start, and the outcome of
+/// each start.
+///
+/// The default policy, `std::execution::par`, hands the starts to the work
+/// stealing scheduler of the standard library backend, so that starts
+/// converging quickly don't leave threads idle.
+///
+/// For a `BatchCost`, the values at all starting points are evaluated first
+/// by batches of plain points, and the lowest one is the first incumbent.
+template <std::size_t M = 8,
+          class S = more_thuente,
+          std::ranges::random_access_range R,
+          class F,
+          class E = std::execution::parallel_policy,
+          Point P = std::ranges::range_value_t<R>>
+    requires Cost<F, P> && std::floating_point<scalar_t<P>> &&
+             std::is_execution_policy_v<E> &&
+             LineSearch<S, line_function<P, F>>
+auto multistart_optimize(const R& starts,
+                         F cost,
+                         const E& policy = std::execution::par,
+                         multistart_options<scalar_t<P>> options = {})
+    -> multistart_result<P>
+{
+    using T = scalar_t<P>;
+
+    const auto n = static_cast<std::size_t>(std::ranges::size(starts));
+    auto results = std::vector<start_result<P>>(n);
+    auto incumbent = std::atomic<T>{std::numeric_limits<T>::infinity()};
+
+    auto values = std::vector<T>{};
+    if constexpr (BatchCost<F, P>) {
+        values = detail::batch_values(starts, cost);
+        for (const auto v : values) {
+            detail::fetch_min(incumbent, v);
+        }
+    }
+
+    const auto dominated = [&incumbent, &options](T value) {
+        const auto best = incumbent.load(std::memory_order_relaxed);
+        const auto margin = options.dominance_margin * (T{1} + stdx::abs(best));
+        return value > best + margin;
+    };
+
+    auto idx = std::vector<std::size_t>(n);
+    std::iota(idx.begin(), idx.end(), std::size_t{});
+
+    const auto run = [&starts,
+                      &cost,
+                      &values,
+                      &results,
+                      &incumbent,
+                      &options,
+                      &dominated](std::size_t i) {
+        using solver_type = impl::lbfgs_solver<M, S, P, F>;
+
+        const auto& start =
+            std::ranges::begin(starts)[static_cast<std::ptrdiff_t>(i)];
+        const auto stop = detail::stop_criteria{options.solver};
+        auto solver = values.empty() ? solver_type{start, cost}
+                                     : solver_type{start, cost, values[i]};
+        detail::fetch_min(incumbent, solver.result().value);
+
+        auto& r = results[i];
+        auto reason = std::optional<stop_reason>{};
+        for (;;) {
+            reason = solver.stopped(stop);
+            if (reason) {
+                break;
+            }
+            if (solver.result().iterations >= options.abandon_after and
+                dominated(solver.result().value)) {
+                r.abandoned = true;
+                break;
+            }
+            if (not solver.step()) {
+                reason = stop_reason::line_search_failed;
+                break;
+            }
+            detail::fetch_min(incumbent, solver.result().value);
+        }
+
+        auto s = std::move(solver).finish(
+            reason.value_or(stop_reason::line_search_failed));
+        r.converged = not r.abandoned and s.converged();
+        r.value = s.value;
+        r.iterations = s.iterations;
+        r.cost_evaluations = s.cost_evaluations;
+        r.gradient_evaluations = s.gradient_evaluations;
+        r.x = std::move(s.x);
+    };
+    std::for_each(policy, idx.cbegin(), idx.cend(), run);
+
+    auto best = n;
+    for (std::size_t i{0}; i < n; ++i) {
+        if (not results[i].abandoned and
+            (best == n or results[i].value < results[best].value)) {
+            best = i;
+        }
+    }
+
+    auto r = multistart_result<P>{};
+    if (best < n) {
+        r.x = results[best].x;
+        r.value = results[best].value;
+        r.best_start = best;
+    }
+    r.starts = std::move(results);
+    return r;
+}
+
+}  // namespace opt
@@ -0,0 +1,239 @@
+#pragma once
+
+#include "src/concepts.hpp"
+#include "src/convopt.hpp"
+#include "src/line_search.hpp"
+#include "src/matrix_ops.hpp"
+#include "src/solver_options.hpp"
+#include "src/spaces.hpp"
+#include "src/sparse_hessian.hpp"
+#include "src/sparse_matrix_ops.hpp"
+#include "src/stdx/cmath.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+namespace opt {
+
+/// Minimizes `cost` from `x` with the damped Newton method, until one of
+/// the criteria of `options` is met
+///
+/// The Hessian is factorized with `modified_cholesky`, which adds a multiple
+/// of the identity only if it is not positive definite, so that the step is
+/// always a descent direction. The step solves the factorized system, no
+/// inverse is formed.
+/// The line search policy `S` tries the full Newton step first, which is
+/// accepted close to the minimum and gives quadratic convergence.
+///
+/// Ends with `stop_reason::factorization_failed` if the Hessian can't be
+/// factorized, e.g. if it has NaN entries. The evaluations of the Hessian are
+/// not counted in the result.
+template <class S = more_thuente, Point P, Cost<P> F>
+    requires TupleSizable<P> && LineSearch<S, line_function<P, F>>
+constexpr auto newton(P x, F cost, solver_options<scalar_t<P>> options = {})
+    -> solve_result<P>
+{
+    using T = scalar_t<P>;
+
+    const auto stop = detail::stop_criteria{options};
+
+    auto r = solve_result<P>{};
+    r.value = cost(x);
+    r.gradient = gradient(x, cost);
+    r.x = std::move(x);
+    r.cost_evaluations = 1;
+    r.gradient_evaluations = 1;
+
+    auto decrease = T{};
+    auto step_length = T{};
+    for (;;) {
+        if (const auto reason = stop(r, decrease, step_length)) {
+            r.reason = *reason;
+            break;
+        }
+
+        auto h = hessian(r.x, cost);
+        if (not(modified_cholesky(h) >= T{})) {
+            r.reason = stop_reason::factorization_failed;
+            break;
+        }
+        const auto d = -cholesky_solve(h, r.gradient);
+
+        auto step = line_search(r.x, d, cost, r.value, r.gradient, S{});
+        r.cost_evaluations += step.cost_evaluations;
+        r.gradient_evaluations += step.gradient_evaluations;
+        if (not(step.alpha > T{})) {
+            r.reason = stop_reason::line_search_failed;
+            break;
+        }
+
+        decrease = r.value - step.value;
+        step_length = step.alpha * stdx::sqrt(norm(d));
+
+        r.x = std::move(step.x);
+        r.value = step.value;
+        r.gradient = std::move(step.gradient);
+        ++r.iterations;
+    }
+
+    return r;
+}
+
+/// Minimizes `cost` from `x` with the damped Newton method, for sparse
+/// Hessians, until one of the criteria of `options` is met
+///
+/// Same iteration as `newton`, with the Hessian evaluated by `sparse_hessian`
+/// and factorized by the sparse `modified_cholesky`. The sparsity pattern and
+/// the symbolic factorization are computed once at `x` and assumed to hold
+/// at every iterate, so each iteration only evaluates the entries of the
+/// pattern and factorizes them numerically. Points of dynamic size are
+/// supported. Ends with `stop_reason::factorization_failed` if the Hessian
+/// can't be factorized.
+///
+/// The evaluations of the Hessian are not counted in the result.
+template <class S = more_thuente, Point P, Cost<P> F>
+    requires LineSearch<S, line_function<P, F>> &&
+             std::regular_invocable<
+                 const F&,
+                 const rebind_point_t<P, sparsity_tracer<scalar_t<P>>>&>
+auto sparse_newton(P x, F cost, solver_options<scalar_t<P>> options = {})
+    -> solve_result<P>
+{
+    using T = scalar_t<P>;
+
+    const auto stop = detail::stop_criteria{options};
+
+    const auto pattern = hessian_sparsity(x, cost);
+    auto factor = sparse_cholesky<T>{analyze_cholesky(pattern)};
+
+    auto r = solve_result<P>{};
+    r.value = cost(x);
+    r.gradient = gradient(x, cost);
+    r.x = std::move(x);
+    r.cost_evaluations = 1;
+    r.gradient_evaluations = 1;
+
+    auto decrease = T{};
+    auto step_length = T{};
+    for (;;) {
+        if (const auto reason = stop(r, decrease, step_length)) {
+            r.reason = *reason;
+            break;
+        }
+
+        if (not(modified_cholesky(sparse_hessian(r.x, cost, pattern),
+                                  factor) >= T{})) {
+            r.reason = stop_reason::factorization_failed;
+            break;
+        }
+        const auto d = -cholesky_solve(factor, r.gradient);
+
+        auto step = line_search(r.x, d, cost, r.value, r.gradient, S{});
+        r.cost_evaluations += step.cost_evaluations;
+        r.gradient_evaluations += step.gradient_evaluations;
+        if (not(step.alpha > T{})) {
+            r.reason = stop_reason::line_search_failed;
+            break;
+        }
+
+        decrease = r.value - step.value;
+        step_length = step.alpha * stdx::sqrt(norm(d));
+
+        r.x = std::move(step.x);
+        r.value = step.value;
+        r.gradient = std::move(step.gradient);
+        ++r.iterations;
+    }
+
+    return r;
+}
+
+/// Minimizes `cost` from `x` with the line search Newton-CG method, until
+/// one of the criteria of `options` is met
+///
+/// Each step solves the Newton system `H d = -g` approximately with the
+/// conjugate gradient method, which only needs the products of the Hessian
+/// with vectors given by `hessian_vector_product`. The Hessian is never
+/// formed, so memory is linear in the dimension and points of dynamic size
+/// are supported.
+/// The conjugate gradient iteration stops once its residual is below
+/// `min(1/2, sqrt(|g|)) |g|`, which gives superlinear convergence, or on a
+/// direction of nonpositive curvature, returning the step found so far, or
+/// `-g` if there is none.
+///
+/// The Hessian-vector products are not counted in the result.
+template <class S = more_thuente, Point P, Cost<P> F>
+    requires LineSearch<S, line_function<P, F>>
+constexpr auto newton_cg(P x, F cost, solver_options<scalar_t<P>> options = {})
+    -> solve_result<P>
+{
+    using T = scalar_t<P>;
+
+    const auto stop = detail::stop_criteria{options};
+
+    auto r = solve_result<P>{};
+    r.value = cost(x);
+    r.gradient = gradient(x, cost);
+    r.x = std::move(x);
+    r.cost_evaluations = 1;
+    r.gradient_evaluations = 1;
+
+    auto decrease = T{};
+    auto step_length = T{};
+    for (;;) {
+        if (const auto reason = stop(r, decrease, step_length)) {
+            r.reason = *reason;
+            break;
+        }
+
+        const auto& g = r.gradient;
+        const auto g2 = norm(g);
+        const auto forcing = std::min(T{0.25F}, stdx::sqrt(g2)) * g2;
+
+        auto d = detail::make_zero<distance_t<P>>(dimension(r.x));
+        auto res = g;
+        auto res2 = g2;
+        auto p = -res;
+        for (std::size_t j{0}; j < dimension(r.x); ++j) {
+            const auto hp = hessian_vector_product(r.x, p, cost);
+            const auto curvature = dot(p, hp);
+            if (not(curvature > T{})) {
+                if (j == 0) {
+                    d = -g;
+                }
+                break;
+            }
+
+            const auto alpha = res2 / curvature;
+            d = d + alpha * p;
+            res = res + alpha * hp;
+            const auto next_res2 = norm(res);
+            if (next_res2 < forcing) {
+                break;
+            }
+            p = next_res2 / res2 * p - res;
+            res2 = next_res2;
+        }
+
+        auto step = line_search(r.x, d, cost, r.value, g, S{});
+        r.cost_evaluations += step.cost_evaluations;
+        r.gradient_evaluations += step.gradient_evaluations;
+        if (not(step.alpha > T{})) {
+            r.reason = stop_reason::line_search_failed;
+            break;
+        }
+
+        decrease = r.value - step.value;
+        step_length = step.alpha * stdx::sqrt(norm(d));
+
+        r.x = std::move(step.x);
+        r.value = step.value;
+        r.gradient = std::move(step.gradient);
+        ++r.iterations;
+    }
+
+    return r;
+}
+
+}  // namespace opt
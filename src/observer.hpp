@@ -0,0 +1,163 @@
+#pragma once
+
+#include "src/concepts.hpp"
+
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+namespace opt {
+
+/// Stage of a solver reported by a `phase_event`
+enum class phase {
+    gradient,
+    hessian,
+    line_search,
+};
+
+/// Sent when a gradient, a Hessian or a line search completes
+///
+/// `elapsed` is zero during constant evaluation. The evaluation counts are
+/// only known for line searches and are zero otherwise.
+struct phase_event {
+    opt::phase phase{};
+    std::chrono::nanoseconds elapsed{};
+    std::size_t cost_evaluations{};
+    std::size_t gradient_evaluations{};
+};
+
+/// Sent at the start of a solver and after each of its steps
+///
+/// Evaluation counts are totals since the start of the solver.
+template <Point P>
+struct iteration_event {
+    std::size_t iteration{};
+    const P& x;
+    scalar_t<P> value{};
+    /// Euclidean norm of the gradient at `x`
+    scalar_t<P> gradient_norm{};
+    /// Length of the last step, relative to the search direction
+    scalar_t<P> step{};
+    std::size_t cost_evaluations{};
+    std::size_t gradient_evaluations{};
+};
+
+/// Returned by an observer to continue or end a solver early
+enum class control {
+    proceed,
+    stop,
+};
+
+/// Observer ignoring all events, the default of the solvers
+struct no_observer {};
+
+/// Totals over the events of a solver run
+///
+/// The gradients evaluated by the line searches are counted in `gradients`,
+/// and their time in both `gradient_time` and `line_search_time`.
+struct solver_stats {
+    std::size_t iterations{};
+    std::size_t cost_evaluations{};
+    std::size_t gradient_evaluations{};
+
+    std::size_t gradients{};
+    std::size_t hessians{};
+    std::size_t line_searches{};
+
+    std::chrono::nanoseconds gradient_time{};
+    std::chrono::nanoseconds hessian_time{};
+    std::chrono::nanoseconds line_search_time{};
+};
+
+/// Observer adding the events it receives to `*stats`
+struct stats_recorder {
+    solver_stats* stats;
+
+    template <Point P>
+    constexpr auto operator()(const iteration_event<P>& e) const -> void
+    {
+        stats->iterations = e.iteration;
+        stats->cost_evaluations = e.cost_evaluations;
+        stats->gradient_evaluations = e.gradient_evaluations;
+    }
+
+    constexpr auto operator()(const phase_event& e) const -> void
+    {
+        switch (e.phase) {
+            case phase::gradient:
+                ++stats->gradients;
+                stats->gradient_time += e.elapsed;
+                break;
+            case phase::hessian:
+                ++stats->hessians;
+                stats->hessian_time += e.elapsed;
+                break;
+            case phase::line_search:
+                ++stats->line_searches;
+                stats->line_search_time += e.elapsed;
+                break;
+        }
+    }
+};
+
+namespace detail {
+
+/// Sends `event` to `observer` if it accepts it
+///
+/// Returns the `control` returned by the observer, or `control::proceed` if
+/// it returns anything else or doesn't accept the event.
+template <class O, class E>
+constexpr auto notify(O& observer, const E& event) -> control
+{
+    if constexpr (std::invocable<O&, const E&>) {
+        if constexpr (std::same_as<std::invoke_result_t<O&, const E&>,
+                                   control>) {
+            return observer(event);
+        } else {
+            observer(event);
+        }
+    }
+    return control::proceed;
+}
+
+/// Runs `f` and sends the time it took to `observer` as a `phase_event`
+/// with `phase` `p`, completed by `complete(event, result)`
+///
+/// The clock is only read if `observer` accepts phase events.
+template <class O, class F, class C>
+constexpr auto timed(O& observer, phase p, const F& f, const C& complete)
+{
+    if constexpr (not std::invocable<O&, const phase_event&>) {
+        return f();
+    } else {
+        using clock = std::chrono::steady_clock;
+
+        if (std::is_constant_evaluated()) {
+            auto r = f();
+            auto e = phase_event{p};
+            complete(e, r);
+            notify(observer, e);
+            return r;
+        }
+
+        const auto start = clock::now();
+        auto r = f();
+        auto e = phase_event{
+            p,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                clock::now() - start)};
+        complete(e, r);
+        notify(observer, e);
+        return r;
+    }
+}
+
+template <class O, class F>
+constexpr auto timed(O& observer, phase p, const F& f)
+{
+    return timed(observer, p, f, [](const auto&, const auto&) {});
+}
+
+}  // namespace detail
+}  // namespace opt
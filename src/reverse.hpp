@@ -0,0 +1,230 @@
+#pragma once
+
+#include "concepts.hpp"
+#include "dualnumbers.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace opt {
+namespace impl {
+
+/// Append-only storage made of fixed size blocks
+///
+/// Elements never move once pushed. `clear` rewinds the arena but keeps the
+/// blocks, so refilling it up to its previous size does not allocate.
+template <class T, std::size_t BlockSize = 4096>
+class arena {
+    static_assert(BlockSize > 0);
+
+    std::vector<std::unique_ptr<T[]>> blocks_{};
+    std::size_t size_{};
+
+  public:
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t
+    {
+        return blocks_.size() * BlockSize;
+    }
+
+    auto push_back(const T& x) -> std::size_t
+    {
+        if (size_ == capacity()) {
+            blocks_.push_back(std::make_unique<T[]>(BlockSize));
+        }
+        (*this)[size_] = x;
+        return size_++;
+    }
+
+    [[nodiscard]] auto operator[](std::size_t n) -> T&
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return blocks_[n / BlockSize][n % BlockSize];
+    }
+    [[nodiscard]] auto operator[](std::size_t n) const -> const T&
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return blocks_[n / BlockSize][n % BlockSize];
+    }
+
+    auto clear() noexcept -> void { size_ = 0; }
+};
+
+/// Wengert list recording the local partial derivatives of every operation
+/// performed on `adjoint` values
+template <Arithmetic T>
+class tape {
+  public:
+    using index_type = std::size_t;
+    static constexpr index_type npos = std::numeric_limits<index_type>::max();
+
+  private:
+    struct node {
+        std::array<index_type, 2> parents{npos, npos};
+        std::array<T, 2> partials{};
+    };
+
+    arena<node> nodes_{};
+    std::vector<T> adjoints_{};
+
+  public:
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+        return nodes_.size();
+    }
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t
+    {
+        return nodes_.capacity();
+    }
+
+    /// Records an independent variable
+    auto variable() -> index_type { return nodes_.push_back({}); }
+
+    /// Records an operation with up to two operands. Operands with index
+    /// `npos` are constants and do not propagate adjoints.
+    auto record(index_type lhs, T dlhs, index_type rhs = npos, T drhs = T{})
+        -> index_type
+    {
+        return nodes_.push_back({{lhs, rhs}, {dlhs, drhs}});
+    }
+
+    /// Propagates the adjoints of node `output` back to every recorded node
+    auto backward(index_type output) -> void
+    {
+        adjoints_.assign(nodes_.size(), T{});
+        adjoints_[output] = T{1};
+
+        for (auto n = output + 1; n-- > 0;) {
+            const auto& x = nodes_[n];
+            const auto a = adjoints_[n];
+            for (std::size_t k{0}; k < 2; ++k) {
+                // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+                if (x.parents[k] != npos) {
+                    adjoints_[x.parents[k]] += x.partials[k] * a;
+                }
+                // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+            }
+        }
+    }
+
+    /// Adjoint of node `n` after the last `backward` call
+    [[nodiscard]] auto adjoint(index_type n) const -> T
+    {
+        return adjoints_[n];
+    }
+
+    /// Forgets every recorded node, retaining the allocated memory
+    auto clear() noexcept -> void { nodes_.clear(); }
+};
+
+/// Scalar recording its operations on a `tape` for reverse-mode
+/// differentiation
+///
+/// Values without a tape are constants.
+template <Arithmetic T>
+struct adjoint {
+    using tape_type = tape<T>;
+    using index_type = typename tape_type::index_type;
+
+    T value{};
+    tape_type* recorder{};
+    index_type index{tape_type::npos};
+
+    adjoint() = default;
+
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    constexpr adjoint(T v) : value{v} {}
+
+    constexpr adjoint(T v, tape_type& t, index_type n)
+        : value{v}, recorder{&t}, index{n}
+    {}
+
+    /// Applies a function with value `v` and derivative `dv` at `value`
+    [[nodiscard]] auto chain(T v, T dv) const -> adjoint
+    {
+        if (recorder == nullptr) {
+            return {v};
+        }
+        return {v, *recorder, recorder->record(index, dv)};
+    }
+
+  private:
+    [[nodiscard]] static auto
+    binary(const adjoint& x, T dx, const adjoint& y, T dy, T v) -> adjoint
+    {
+        // Adjoints recorded on different tapes can't be combined
+        assert(x.recorder == nullptr or y.recorder == nullptr or
+               x.recorder == y.recorder);
+        auto* t = (x.recorder != nullptr) ? x.recorder : y.recorder;
+        if (t == nullptr) {
+            return {v};
+        }
+        return {v, *t, t->record(x.index, dx, y.index, dy)};
+    }
+
+  public:
+    [[nodiscard]] friend auto operator+(const adjoint& x, const adjoint& y)
+        -> adjoint
+    {
+        return binary(x, T{1}, y, T{1}, x.value + y.value);
+    }
+
+    [[nodiscard]] friend auto operator-(const adjoint& x, const adjoint& y)
+        -> adjoint
+    {
+        return binary(x, T{1}, y, -T{1}, x.value - y.value);
+    }
+
+    [[nodiscard]] friend auto operator*(const adjoint& x, const adjoint& y)
+        -> adjoint
+    {
+        return binary(x, y.value, y, x.value, x.value * y.value);
+    }
+
+    [[nodiscard]] friend auto operator/(const adjoint& x, const adjoint& y)
+        -> adjoint
+    {
+        const auto r = x.value / y.value;
+        return binary(x, T{1} / y.value, y, -r / y.value, r);
+    }
+
+    [[nodiscard]] friend auto operator-(const adjoint& x) -> adjoint
+    {
+        return x.chain(-x.value, -T{1});
+    }
+
+    auto operator+=(const adjoint& x) -> adjoint& { return *this = *this + x; }
+    auto operator-=(const adjoint& x) -> adjoint& { return *this = *this - x; }
+    auto operator*=(const adjoint& x) -> adjoint& { return *this = *this * x; }
+    auto operator/=(const adjoint& x) -> adjoint& { return *this = *this / x; }
+
+    friend auto operator<<(std::ostream& os, const adjoint& x) -> std::ostream&
+    {
+        os << x.value;
+        return os;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator<(const adjoint& x, const adjoint& y) -> bool
+    {
+        return x.value < y.value;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator==(const adjoint& x, const adjoint& y) -> bool
+    {
+        return x.value == y.value;
+    }
+};
+
+}  // namespace impl
+
+using impl::adjoint;
+using impl::tape;
+
+}  // namespace opt
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <execution>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+namespace opt {
+namespace detail {
+
+/// Archetype of the work handed to a scheduler, running the tasks
+/// `[first, last)`
+struct task_range {
+    auto operator()(std::size_t first, std::size_t last) const -> void;
+};
+
+}  // namespace detail
+
+/// Runs `n` independent tasks with `s(n, f)`, calling `f(first, last)` on
+/// disjoint ranges covering `[0, n)`
+///
+/// `f` may be called concurrently from several threads. Any callable with
+/// this signature can be used to hand the tasks to another executor.
+template <class S>
+concept Scheduler =
+    std::copy_constructible<S> &&
+    std::invocable<const S&, std::size_t, const detail::task_range&>;
+
+/// Runs all tasks on the calling thread
+struct serial {
+    template <class F>
+    constexpr auto operator()(std::size_t n, const F& f) const -> void
+    {
+        if (n > 0) {
+            f(std::size_t{}, n);
+        }
+    }
+};
+
+/// Runs tasks with the parallel algorithms of the standard library, in
+/// chunks of `grain` consecutive tasks
+struct parallel {
+    std::size_t grain{1};
+
+    template <class F>
+    auto operator()(std::size_t n, const F& f) const -> void
+    {
+        const auto g = std::max(grain, std::size_t{1});
+        if (n <= g) {
+            serial{}(n, f);
+            return;
+        }
+
+        auto chunks = std::vector<std::size_t>((n + g - 1) / g);
+        std::iota(chunks.begin(), chunks.end(), std::size_t{});
+        const auto run = [&f, g, n](std::size_t c) {
+            f(c * g, std::min(c * g + g, n));
+        };
+#ifdef __cpp_lib_execution
+        std::for_each(
+            std::execution::par_unseq, chunks.cbegin(), chunks.cend(), run);
+#else
+        std::for_each(chunks.cbegin(), chunks.cend(), run);
+#endif
+    }
+};
+
+/// Times the first task, then runs the others serially if they would take
+/// less than `serial_below` in total, and in parallel otherwise, with as
+/// many tasks per chunk as fit in `chunk_duration`
+///
+/// Starting parallel tasks costs several microseconds, more than the whole
+/// work for small problems with cheap cost functions.
+struct adaptive {
+    std::chrono::nanoseconds serial_below{std::chrono::microseconds{50}};
+    std::chrono::nanoseconds chunk_duration{std::chrono::microseconds{10}};
+
+    template <class F>
+    auto operator()(std::size_t n, const F& f) const -> void
+    {
+        using clock = std::chrono::steady_clock;
+
+        if (n == 0) {
+            return;
+        }
+        const auto start = clock::now();
+        f(std::size_t{}, std::size_t{1});
+        const auto task = std::max(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                clock::now() - start),
+            std::chrono::nanoseconds{1});
+
+        const auto rest = n - 1;
+        if (task * static_cast<std::chrono::nanoseconds::rep>(rest) <
+            serial_below) {
+            serial{}(rest, [&f](std::size_t first, std::size_t last) {
+                f(first + 1, last + 1);
+            });
+            return;
+        }
+        const auto grain = static_cast<std::size_t>(chunk_duration / task);
+        parallel{grain}(rest, [&f](std::size_t first, std::size_t last) {
+            f(first + 1, last + 1);
+        });
+    }
+};
+
+namespace detail {
+
+/// Runs `n` tasks with `s`, or serially during constant evaluation
+template <Scheduler S, class F>
+constexpr auto schedule(const S& s, std::size_t n, const F& f) -> void
+{
+    if (std::is_constant_evaluated()) {
+        serial{}(n, f);
+        return;
+    }
+    s(n, f);
+}
+
+}  // namespace detail
+}  // namespace opt
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "src/concepts.hpp"
+#include "src/spaces.hpp"
+#include "src/stdx/cmath.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+namespace opt {
+
+/// Stopping criteria of a solver
+///
+/// A run stops as soon as any criterion is met. The tolerances on the change
+/// of the value and on the step are disabled when zero.
+template <class T>
+struct solver_options {
+    /// Stops once the Euclidean norm of the gradient is below
+    /// `gradient_tolerance`
+    T gradient_tolerance{1e-4F};
+    /// Stops once a step lowers the value by less than
+    /// `value_tolerance * (1 + |value|)`
+    T value_tolerance{};
+    /// Stops once the Euclidean norm of a step is below `step_tolerance`
+    T step_tolerance{};
+
+    std::size_t max_iterations{100};
+    /// Stops once the evaluations of the cost and of its gradient add up to
+    /// `max_evaluations`
+    std::size_t max_evaluations{std::numeric_limits<std::size_t>::max()};
+    /// Stops once the run has taken longer than `time_budget`, not checked
+    /// during constant evaluation
+    std::chrono::nanoseconds time_budget{std::chrono::nanoseconds::max()};
+};
+
+/// Criterion that ended a solver run
+enum class stop_reason {
+    gradient_tolerance,
+    value_tolerance,
+    step_tolerance,
+    max_iterations,
+    max_evaluations,
+    time_budget,
+    /// The line search found no step lowering the value
+    line_search_failed,
+    /// The trust region shrank without finding a step lowering the value, or
+    /// the model had no step
+    trust_region_failed,
+    /// The matrix of a step could not be factorized, e.g. a Hessian with NaN
+    /// entries
+    factorization_failed,
+    /// An observer returned `control::stop`
+    observer,
+};
+
+/// Outcome of a solver run
+template <Point P>
+struct solve_result {
+    /// Last point reached, with the value and gradient there
+    P x;
+    scalar_t<P> value{};
+    distance_t<P> gradient;
+
+    std::size_t iterations{};
+    std::size_t cost_evaluations{};
+    std::size_t gradient_evaluations{};
+
+    stop_reason reason{};
+
+    /// Whether the run ended on one of the tolerances
+    [[nodiscard]] constexpr auto converged() const -> bool
+    {
+        return reason == stop_reason::gradient_tolerance or
+               reason == stop_reason::value_tolerance or
+               reason == stop_reason::step_tolerance;
+    }
+};
+
+namespace detail {
+
+/// Checks the criteria of `options` between the iterations of a solver
+///
+/// The clock starts on construction, and is not read during constant
+/// evaluation or without a time budget.
+template <class T>
+class stop_criteria {
+    using clock = std::chrono::steady_clock;
+
+    solver_options<T> options_;
+    bool timed_;
+    clock::time_point start_;
+
+  public:
+    constexpr explicit stop_criteria(const solver_options<T>& options)
+        : options_{options},
+          timed_{options.time_budget != clock::duration::max() and
+                 not std::is_constant_evaluated()},
+          start_{timed_ ? clock::now() : clock::time_point{}}
+    {}
+
+    /// Criterion met by the run `r`, if any
+    ///
+    /// `decrease` and `step` are the decrease of the value and the length of
+    /// the last step. They are only checked after a first iteration, and if
+    /// the last step was accepted.
+    template <Point P>
+    [[nodiscard]] constexpr auto operator()(const solve_result<P>& r,
+                                            T decrease,
+                                            T step,
+                                            bool accepted = true) const
+        -> std::optional<stop_reason>
+    {
+        if (norm(r.gradient) <
+            options_.gradient_tolerance * options_.gradient_tolerance) {
+            return stop_reason::gradient_tolerance;
+        }
+        const auto moved = r.iterations > 0 and accepted;
+        if (moved and decrease < options_.value_tolerance *
+                                     (T{1} + stdx::abs(r.value))) {
+            return stop_reason::value_tolerance;
+        }
+        if (moved and step < options_.step_tolerance) {
+            return stop_reason::step_tolerance;
+        }
+        if (r.iterations >= options_.max_iterations) {
+            return stop_reason::max_iterations;
+        }
+        if (r.cost_evaluations + r.gradient_evaluations >=
+            options_.max_evaluations) {
+            return stop_reason::max_evaluations;
+        }
+        if (timed_ and clock::now() - start_ > options_.time_budget) {
+            return stop_reason::time_budget;
+        }
+        return std::nullopt;
+    }
+};
+
+}  // namespace detail
+}  // namespace opt
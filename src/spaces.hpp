@@ -1,20 +1,84 @@
 #pragma once
 
 #include "concepts.hpp"
+#include "impl/aligned_allocator.hpp"
+#include "impl/simd.hpp"
 #include "stdx/traits.hpp"
 
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <cstddef>
 #include <functional>
+#include <initializer_list>
 #include <iostream>
+#include <memory>
 #include <numeric>
 #include <ranges>
 #include <utility>
+#include <vector>
 
 namespace opt {
 
+/// Number of coordinates of `x`
+template <Sizable T>
+[[nodiscard]] constexpr auto dimension(const T& x) -> std::size_t
+{
+    if constexpr (TupleSizable<T>) {
+        return std::tuple_size_v<T>;
+    } else {
+        return x.size();
+    }
+}
+
 namespace detail {
+
+/// Storage of `T` can be handed to the kernels in `impl::simd`
+template <class T>
+concept simd_contiguous = impl::simd::Vectorizable<typename T::entries_types>;
+
+/// Coordinate-wise `r = x + y`
+template <class X, class Y, class R>
+constexpr auto add(const X& x, const Y& y, R& r) -> void
+{
+    if constexpr (simd_contiguous<R>) {
+        if (not std::is_constant_evaluated()) {
+            impl::simd::add(
+                x.data.data(), y.data.data(), r.data.data(), r.data.size());
+            return;
+        }
+    }
+    std::transform(x.cbegin(), x.cend(), y.cbegin(), r.begin(), std::plus{});
+}
+
+/// Coordinate-wise `r = x - y`
+template <class X, class Y, class R>
+constexpr auto sub(const X& x, const Y& y, R& r) -> void
+{
+    if constexpr (simd_contiguous<R>) {
+        if (not std::is_constant_evaluated()) {
+            impl::simd::sub(
+                x.data.data(), y.data.data(), r.data.data(), r.data.size());
+            return;
+        }
+    }
+    std::transform(x.cbegin(), x.cend(), y.cbegin(), r.begin(), std::minus{});
+}
+
+/// Coordinate-wise `r = s * x`
+template <class S, class X, class R>
+constexpr auto scale(const S& s, const X& x, R& r) -> void
+{
+    if constexpr (simd_contiguous<R>) {
+        if (not std::is_constant_evaluated()) {
+            impl::simd::scale(s, x.data.data(), r.data.data(), r.data.size());
+            return;
+        }
+    }
+    std::transform(
+        x.cbegin(), x.cend(), r.begin(), [&s](const auto& c) { return s * c; });
+}
+
 struct close_to_fn {
   private:
     template <class T1, class T2, class S>
@@ -46,12 +110,24 @@ struct close_to_fn {
             return x;
         };
 
-        return [&lhs, &rhs, &tol,
-                abs ]<std::size_t... Is>(std::index_sequence<Is...>)
-        {
-            return ((abs(lhs[Is] - rhs[Is]) < tol) && ...);
+        if constexpr (DynamicSizable<T>) {
+            if (lhs.size() != rhs.size()) {
+                return false;
+            }
+            for (std::size_t i{0}; i < lhs.size(); ++i) {
+                if (not(abs(lhs[i] - rhs[i]) < tol)) {
+                    return false;
+                }
+            }
+            return true;
+        } else {
+            return [&lhs, &rhs, &tol,
+                    abs ]<std::size_t... Is>(std::index_sequence<Is...>)
+            {
+                return ((abs(lhs[Is] - rhs[Is]) < tol) && ...);
+            }
+            (std::make_index_sequence<std::tuple_size_v<T>>{});
         }
-        (std::make_index_sequence<std::tuple_size_v<T>>{});
     }
 
   public:
@@ -81,11 +157,53 @@ template <class T>
              [nodiscard]] constexpr auto
     norm(const T& v) -> scalar_t<T>
 {
-    return [&v]<std::size_t... Is>(std::index_sequence<Is...>)
-    {
-        return ((v[Is] * v[Is]) + ...);
+    if constexpr (detail::simd_contiguous<T>) {
+        if (not std::is_constant_evaluated()) {
+            return impl::simd::squared_norm(v.data.data(), v.data.size());
+        }
+    }
+    if constexpr (DynamicSizable<T>) {
+        auto r = scalar_t<T>{};
+        for (const auto& x : v) {
+            r += x * x;
+        }
+        return r;
+    } else {
+        return [&v]<std::size_t... Is>(std::index_sequence<Is...>)
+        {
+            return ((v[Is] * v[Is]) + ...);
+        }
+        (std::make_index_sequence<std::tuple_size_v<T>>{});
+    }
+}
+
+/// Scalar product of `v1` and `v2`
+template <class T>
+    requires Vector<T> [
+             [nodiscard]] constexpr auto
+    dot(const T& v1, const T& v2) -> scalar_t<T>
+{
+    if constexpr (detail::simd_contiguous<T>) {
+        if (not std::is_constant_evaluated()) {
+            assert(v1.data.size() == v2.data.size());
+            return impl::simd::dot(
+                v1.data.data(), v2.data.data(), v1.data.size());
+        }
+    }
+    if constexpr (DynamicSizable<T>) {
+        assert(v1.size() == v2.size());
+        auto r = scalar_t<T>{};
+        for (std::size_t i{0}; i < v1.size(); ++i) {
+            r += v1[i] * v2[i];
+        }
+        return r;
+    } else {
+        return [&v1, &v2]<std::size_t... Is>(std::index_sequence<Is...>)
+        {
+            return ((v1[Is] * v2[Is]) + ...);
+        }
+        (std::make_index_sequence<std::tuple_size_v<T>>{});
     }
-    (std::make_index_sequence<std::tuple_size_v<T>>{});
 }
 
 template <class T>
@@ -192,6 +310,89 @@ struct entity<derived<T, N>> {
     // NOLINTEND(modernize-use-equals-delete)
 };
 
+template <Arithmetic T, class Alloc, template <class, class> class derived>
+struct entity<derived<T, Alloc>> {
+
+    using entries_types = T;
+    using allocator_type = Alloc;
+    using coords_type = std::vector<T, Alloc>;
+
+    coords_type data{};
+
+    [[nodiscard]] constexpr auto size() const noexcept -> std::size_t
+    {
+        return data.size();
+    }
+    [[nodiscard]] constexpr auto get_allocator() const -> allocator_type
+    {
+        return data.get_allocator();
+    }
+
+    [[nodiscard]] constexpr auto begin() & noexcept { return data.begin(); }
+    [[nodiscard]] constexpr auto begin() const& noexcept
+    {
+        return data.begin();
+    }
+    [[nodiscard]] constexpr auto cbegin() const& noexcept
+    {
+        return data.cbegin();
+    }
+
+    [[nodiscard]] constexpr auto end() & noexcept { return data.end(); }
+    [[nodiscard]] constexpr auto end() const& noexcept { return data.end(); }
+    [[nodiscard]] constexpr auto cend() const& noexcept { return data.cend(); }
+
+    [[nodiscard]] constexpr auto
+    operator[](typename coords_type::size_type n) & -> auto&
+    {
+        return data[n];
+    }
+    [[nodiscard]] constexpr auto
+    operator[](typename coords_type::size_type n) const& -> auto&
+    {
+        return data[n];
+    }
+
+    friend auto operator<<(std::ostream& os, const entity& p) -> std::ostream&
+    {
+        os << "(";
+        for (std::size_t i{0}; i < p.size(); ++i) {
+            os << (i == 0 ? "" : ", ") << p[i];
+        }
+        os << ")";
+        return os;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator==(const entity& lhs, const entity& rhs) -> bool = default;
+
+  private:
+    friend derived<T, Alloc>;
+
+    // NOLINTBEGIN(performance-noexcept-move-constructor)
+
+    entity() = default;
+    constexpr ~entity() = default;
+    entity(entity&&) = default;
+    entity(const entity&) = default;
+    auto operator=(entity&&) -> entity& = default;
+    auto operator=(const entity&) -> entity& = default;
+
+    // NOLINTEND(performance-noexcept-move-constructor)
+
+    // NOLINTBEGIN(modernize-use-equals-delete)
+
+    constexpr entity(std::size_t n, const T& value, const Alloc& alloc)
+        : data(n, value, alloc)
+    {}
+
+    constexpr entity(std::initializer_list<T> list, const Alloc& alloc)
+        : data(list, alloc)
+    {}
+
+    // NOLINTEND(modernize-use-equals-delete)
+};
+
 /// A simple vector class
 template <Arithmetic T, std::size_t N>
 struct vector : entity<vector<T, N>> {
@@ -218,24 +419,23 @@ struct vector : entity<vector<T, N>> {
     operator+(const vector& v1, const vector& v2) -> vector
     {
         auto r = vector{};
-        std::transform(
-            v1.cbegin(), v1.cend(), v2.cbegin(), r.begin(), std::plus{});
+        detail::add(v1, v2, r);
         return r;
     }
 
     [[nodiscard]] friend constexpr auto
     operator-(const vector& v1, const vector& v2) -> vector
     {
-        return v1 + (-v2);
+        auto r = vector{};
+        detail::sub(v1, v2, r);
+        return r;
     }
 
     [[nodiscard]] friend constexpr auto operator*(const vector& v, const T& s)
         -> vector
     {
         auto r = vector{};
-        std::transform(v.cbegin(), v.cend(), r.begin(), [s](auto x) {
-            return s * x;
-        });
+        detail::scale(s, v, r);
         return r;
     }
 
@@ -264,8 +464,7 @@ struct point : entity<point<T, N>> {
     operator-(const point& p, const point& q) -> vector<T, N>
     {
         auto v = vector<T, N>{};
-        std::transform(
-            p.cbegin(), p.cend(), q.cbegin(), v.begin(), std::minus{});
+        detail::sub(p, q, v);
         return v;
     }
 
@@ -273,8 +472,7 @@ struct point : entity<point<T, N>> {
     operator-(const point& p, const vector<T, N>& v) -> point
     {
         auto r = point{};
-        std::transform(
-            p.cbegin(), p.cend(), v.cbegin(), r.begin(), std::minus{});
+        detail::sub(p, v, r);
         return r;
     }
 
@@ -282,8 +480,7 @@ struct point : entity<point<T, N>> {
     operator+(const point& p, const vector<T, N>& v) -> point
     {
         auto r = point{};
-        std::transform(
-            p.cbegin(), p.cend(), v.cbegin(), r.begin(), std::plus{});
+        detail::add(p, v, r);
         return r;
     }
 
@@ -297,6 +494,135 @@ struct point : entity<point<T, N>> {
 template <class... Ts>
 point(Ts...) -> point<std::common_type_t<Ts...>, sizeof...(Ts)>;
 
+/// A vector with the number of coordinates chosen at runtime
+template <Arithmetic T, class Alloc = impl::aligned_allocator<T>>
+struct dyn_vector : entity<dyn_vector<T, Alloc>> {
+    dyn_vector() = default;
+
+    explicit constexpr dyn_vector(std::size_t n,
+                                  const T& value = T{},
+                                  const Alloc& alloc = Alloc{})
+        : entity<dyn_vector>(n, value, alloc)
+    {}
+
+    explicit constexpr dyn_vector(std::initializer_list<T> list,
+                                  const Alloc& alloc = Alloc{})
+        : entity<dyn_vector>(list, alloc)
+    {}
+
+    [[nodiscard]] friend constexpr auto operator-(const dyn_vector& v)
+        -> dyn_vector
+    {
+        auto r = dyn_vector(v.size(), T{}, v.get_allocator());
+        std::transform(v.cbegin(), v.cend(), r.begin(), std::negate{});
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator+(const dyn_vector& v1, const dyn_vector& v2) -> dyn_vector
+    {
+        assert(v1.size() == v2.size());
+        auto r = dyn_vector(v1.size(), T{}, v1.get_allocator());
+        detail::add(v1, v2, r);
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator-(const dyn_vector& v1, const dyn_vector& v2) -> dyn_vector
+    {
+        assert(v1.size() == v2.size());
+        auto r = dyn_vector(v1.size(), T{}, v1.get_allocator());
+        detail::sub(v1, v2, r);
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator*(const dyn_vector& v, const T& s) -> dyn_vector
+    {
+        auto r = dyn_vector(v.size(), T{}, v.get_allocator());
+        detail::scale(s, v, r);
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator*(const T& s, const dyn_vector& v) -> dyn_vector
+    {
+        return v * s;
+    }
+};
+
+/// A point with the number of coordinates chosen at runtime
+template <Arithmetic T, class Alloc = impl::aligned_allocator<T>>
+struct dyn_point : entity<dyn_point<T, Alloc>> {
+    dyn_point() = default;
+
+    explicit constexpr dyn_point(std::size_t n,
+                                 const T& value = T{},
+                                 const Alloc& alloc = Alloc{})
+        : entity<dyn_point>(n, value, alloc)
+    {}
+
+    explicit constexpr dyn_point(std::initializer_list<T> list,
+                                 const Alloc& alloc = Alloc{})
+        : entity<dyn_point>(list, alloc)
+    {}
+
+    [[nodiscard]] friend constexpr auto
+    operator-(const dyn_point& p, const dyn_point& q) -> dyn_vector<T, Alloc>
+    {
+        assert(p.size() == q.size());
+        auto v = dyn_vector<T, Alloc>(p.size(), T{}, p.get_allocator());
+        detail::sub(p, q, v);
+        return v;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator-(const dyn_point& p, const dyn_vector<T, Alloc>& v) -> dyn_point
+    {
+        assert(p.size() == v.size());
+        auto r = dyn_point(p.size(), T{}, p.get_allocator());
+        detail::sub(p, v, r);
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator+(const dyn_point& p, const dyn_vector<T, Alloc>& v) -> dyn_point
+    {
+        assert(p.size() == v.size());
+        auto r = dyn_point(p.size(), T{}, p.get_allocator());
+        detail::add(p, v, r);
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator+(const dyn_vector<T, Alloc>& v, const dyn_point& p) -> dyn_point
+    {
+        return p + v;
+    }
+};
+
+template <class T, class Alloc, class S>
+struct rebind_point<dyn_point<T, Alloc>, S> {
+    using type = dyn_point<
+        S,
+        typename std::allocator_traits<Alloc>::template rebind_alloc<S>>;
+};
+
+namespace detail {
+
+/// Zero initialized entity with `n` coordinates
+template <class R>
+[[nodiscard]] constexpr auto make_zero([[maybe_unused]] std::size_t n) -> R
+{
+    if constexpr (TupleSizable<R>) {
+        return R{};
+    } else {
+        return R(n);
+    }
+}
+
+}  // namespace detail
+
 }  // namespace opt
 
 template <class T, std::size_t Size>
@@ -0,0 +1,266 @@
+#pragma once
+
+#include "src/concepts.hpp"
+#include "src/convopt.hpp"
+#include "src/dualnumbers.hpp"
+#include "src/schedule.hpp"
+#include "src/spaces.hpp"
+#include "src/sparse_matrix.hpp"
+#include "src/sparsity_tracer.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace opt {
+
+/// Assignment of a color `colors[i]` in `[0, count)` to each coordinate `i`
+struct coloring {
+    std::vector<std::size_t> colors{};
+    std::size_t count{};
+};
+
+/// Computes the sparsity pattern of the Hessian of `cost` at `p`, with a
+/// single cost evaluation on `sparsity_tracer` numbers
+///
+/// The pattern is symmetric and may contain entries that are zero at `p`,
+/// but no nonzero entry is missing.
+template <Point P, Cost<P> F>
+    requires std::regular_invocable<
+        const F&,
+        const rebind_point_t<P, sparsity_tracer<scalar_t<P>>>&>
+constexpr auto hessian_sparsity(const P& p, F cost) -> sparsity_pattern
+{
+    using T = sparsity_tracer<scalar_t<P>>;
+
+    const auto n = dimension(p);
+    auto q = detail::make_zero<rebind_point_t<P, T>>(n);
+    for (std::size_t i{0}; i < n; ++i) {
+        q[i] = T::variable(p[i], i);
+    }
+
+    const auto y = T{cost(q)};
+    auto entries = std::vector<std::pair<std::size_t, std::size_t>>{};
+    entries.reserve(2 * y.hessian.size());
+    for (const auto& [i, j] : y.hessian) {
+        entries.emplace_back(i, j);
+        if (i != j) {
+            entries.emplace_back(j, i);
+        }
+    }
+    return sparsity_pattern::from_entries(n, n, std::move(entries));
+}
+
+/// Colors the coordinates so that the entries of a symmetric matrix with
+/// the square `pattern` can be recovered from its products with the sums of
+/// the columns of each color
+///
+/// Computes a star coloring of the graph with an edge for each off-diagonal
+/// entry: adjacent coordinates have different colors, and every path on four
+/// coordinates uses at least three colors. Each entry `(i, j)` is then the
+/// only contribution to row `i` of the product with the color of `j`, or to
+/// row `j` of the product with the color of `i`.
+///
+/// The coordinates are colored greedily in order, each with the smallest
+/// color not making a path on four colored coordinates bicolored.
+constexpr auto star_coloring(const sparsity_pattern& pattern) -> coloring
+{
+    constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+    const auto n = pattern.rows;
+    auto c = coloring{std::vector<std::size_t>(n, none)};
+
+    // forbidden[k] == v if v can't take color k, seen[k] == v if a neighbor
+    // of v has color k and repeated[k] == v if at least two have
+    auto forbidden = std::vector<std::size_t>{};
+    auto seen = std::vector<std::size_t>{};
+    auto repeated = std::vector<std::size_t>{};
+
+    const auto colored_neighbors = [&pattern, &c](std::size_t v, auto f) {
+        for (const auto w : pattern.row(v)) {
+            if (w != v and c.colors[w] != none) {
+                f(w);
+            }
+        }
+    };
+
+    for (std::size_t v{0}; v < n; ++v) {
+        colored_neighbors(v, [&](std::size_t w) {
+            const auto k = c.colors[w];
+            forbidden[k] = v;
+            if (seen[k] == v) {
+                repeated[k] = v;
+            }
+            seen[k] = v;
+        });
+
+        colored_neighbors(v, [&](std::size_t w) {
+            colored_neighbors(w, [&](std::size_t x) {
+                if (x == v) {
+                    return;
+                }
+                // y - v - w - x, with y another neighbor of v colored as w
+                if (repeated[c.colors[w]] == v) {
+                    forbidden[c.colors[x]] = v;
+                    return;
+                }
+                // v - w - x - y, with y another neighbor of x colored as w
+                colored_neighbors(x, [&](std::size_t y) {
+                    if (y != w and c.colors[y] == c.colors[w]) {
+                        forbidden[c.colors[x]] = v;
+                    }
+                });
+            });
+        });
+
+        auto k = std::size_t{};
+        while (k < c.count and forbidden[k] == v) {
+            ++k;
+        }
+        if (k == c.count) {
+            ++c.count;
+            forbidden.push_back(none);
+            seen.push_back(none);
+            repeated.push_back(none);
+        }
+        c.colors[v] = k;
+    }
+
+    return c;
+}
+
+/// Computes the entries of the Hessian of `cost` at `p` in the symmetric
+/// `pattern`, one cost evaluation per entry of the upper triangle
+///
+/// Entries outside of `pattern` are taken as zero. The evaluations are run
+/// by the scheduler `s`.
+template <Point P, Cost<P> F, Scheduler S = adaptive>
+constexpr auto sparse_hessian(const P& p,
+                              F cost,
+                              const sparsity_pattern& pattern,
+                              S s = {}) -> csr_matrix<scalar_t<P>>
+{
+    using T = scalar_t<P>;
+
+    // Rows and positions of the entries of the upper triangle
+    auto upper = std::vector<std::pair<std::size_t, std::size_t>>{};
+    for (std::size_t i{0}; i < pattern.rows; ++i) {
+        for (auto k = pattern.offsets[i]; k < pattern.offsets[i + 1]; ++k) {
+            if (pattern.indices[k] >= i) {
+                upper.emplace_back(i, k);
+            }
+        }
+    }
+
+    auto h = csr_matrix<T>{pattern, std::vector<T>(pattern.nonzeros())};
+    auto set_range = [&h, &cost, &upper, d = detail::as_point_dual(p)](
+                         std::size_t first, std::size_t last) {
+        auto dij = d;
+        for (auto k = first; k < last; ++k) {
+            const auto [i, ij] = upper[k];
+            const auto j = h.pattern.indices[ij];
+
+            dij[i].e1 = 1;
+            dij[j].e2 = 1;
+            h.values[ij] = cost(dij).e3;
+            h.values[h.pattern.find(j, i)] = h.values[ij];
+            dij[i].e1 = 0;
+            dij[j].e2 = 0;
+        }
+    };
+
+    detail::schedule(s, upper.size(), set_range);
+    return h;
+}
+
+/// Computes the entries of the Hessian of `cost` at `p` in the symmetric
+/// `pattern`, one cost evaluation per color of `star_coloring(pattern)`
+///
+/// Each evaluation seeds `e1` on all the coordinates of a color, giving the
+/// product of the Hessian with the sum of their columns, from which the
+/// entries are read directly. Entries outside of `pattern` are taken as
+/// zero, and the result is exactly symmetric.
+template <Point P, HyperVectorCost<P> F, Scheduler S = adaptive>
+constexpr auto sparse_hessian(const P& p,
+                              F cost,
+                              const sparsity_pattern& pattern,
+                              S s = {}) -> csr_matrix<scalar_t<P>>
+{
+    using T = scalar_t<P>;
+    constexpr auto N = std::tuple_size_v<P>;
+    constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+    const auto c = star_coloring(pattern);
+
+    auto products = std::vector<std::array<T, N>>(c.count);
+    auto set_colors = [&products,
+                       &cost,
+                       &c,
+                       d = detail::as_point_hyper_dual_vec(p)](
+                          std::size_t first, std::size_t last) {
+        auto dk = d;
+        for (auto k = first; k < last; ++k) {
+            for (std::size_t i{0}; i < N; ++i) {
+                dk[i].e1 = c.colors[i] == k ? T{1} : T{};
+            }
+            products[k] = cost(dk).e3;
+        }
+    };
+    detail::schedule(s, c.count, set_colors);
+
+    auto h = csr_matrix<T>{pattern, std::vector<T>(pattern.nonzeros())};
+
+    // repeated[k] == i if at least two neighbors of i have color k
+    auto seen = std::vector<std::size_t>(c.count, none);
+    auto repeated = std::vector<std::size_t>(c.count, none);
+
+    for (std::size_t i{0}; i < N; ++i) {
+        for (const auto j : pattern.row(i)) {
+            const auto k = c.colors[j];
+            if (j != i and seen[k] == i) {
+                repeated[k] = i;
+            }
+            seen[k] = i;
+        }
+
+        for (auto ij = pattern.offsets[i]; ij < pattern.offsets[i + 1]; ++ij) {
+            const auto j = pattern.indices[ij];
+            if (j < i) {
+                continue;
+            }
+
+            const auto ci = c.colors[i];
+            const auto cj = c.colors[j];
+            // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+            h.values[ij] =
+                repeated[cj] == i ? products[ci][j] : products[cj][i];
+            // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+            if (j != i) {
+                h.values[pattern.find(j, i)] = h.values[ij];
+            }
+        }
+    }
+
+    return h;
+}
+
+/// Computes the Hessian of `cost` at `p` with `sparse_hessian`, on the
+/// pattern found by `hessian_sparsity`
+///
+/// When evaluating the Hessian at many points with the same pattern, find
+/// the pattern once and pass it to `sparse_hessian` instead.
+template <Point P, Cost<P> F, Scheduler S = adaptive>
+    requires std::regular_invocable<
+        const F&,
+        const rebind_point_t<P, sparsity_tracer<scalar_t<P>>>&>
+constexpr auto sparse_hessian(const P& p, F cost, S s = {})
+    -> csr_matrix<scalar_t<P>>
+{
+    return sparse_hessian(p, cost, hessian_sparsity(p, cost), s);
+}
+
+}  // namespace opt
@@ -0,0 +1,292 @@
+#pragma once
+
+#include "concepts.hpp"
+#include "schedule.hpp"
+#include "spaces.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <iostream>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace opt {
+
+/// Positions of the nonzero entries of a `rows`x`cols` matrix, in
+/// compressed sparse row format
+///
+/// The column indices of row `i` are `indices[offsets[i]]` to
+/// `indices[offsets[i + 1] - 1]`, in increasing order. The pattern of a
+/// symmetric matrix is also its compressed sparse column format.
+struct sparsity_pattern {
+    std::size_t rows{};
+    std::size_t cols{};
+    std::vector<std::size_t> offsets{0};
+    std::vector<std::size_t> indices{};
+
+    /// Builds the pattern from `(row, column)` pairs, in any order and
+    /// possibly repeated
+    [[nodiscard]] static constexpr auto
+    from_entries(std::size_t rows,
+                 std::size_t cols,
+                 std::vector<std::pair<std::size_t, std::size_t>> entries)
+        -> sparsity_pattern
+    {
+        std::ranges::sort(entries);
+        const auto repeated = std::ranges::unique(entries);
+        entries.erase(repeated.begin(), repeated.end());
+
+        auto p = sparsity_pattern{rows, cols};
+        p.offsets.assign(rows + 1, 0);
+        p.indices.reserve(entries.size());
+        for (const auto& [i, j] : entries) {
+            ++p.offsets[i + 1];
+            p.indices.push_back(j);
+        }
+        for (std::size_t i{0}; i < rows; ++i) {
+            p.offsets[i + 1] += p.offsets[i];
+        }
+        return p;
+    }
+
+    [[nodiscard]] constexpr auto nonzeros() const -> std::size_t
+    {
+        return indices.size();
+    }
+
+    /// Column indices of the nonzero entries of row `i`
+    [[nodiscard]] constexpr auto row(std::size_t i) const
+        -> std::span<const std::size_t>
+    {
+        return std::span{indices}.subspan(offsets[i],
+                                          offsets[i + 1] - offsets[i]);
+    }
+
+    /// Position of the entry `(i, j)` in `indices`, `nonzeros()` if it isn't
+    /// in the pattern
+    [[nodiscard]] constexpr auto find(std::size_t i, std::size_t j) const
+        -> std::size_t
+    {
+        const auto r = row(i);
+        const auto it = std::ranges::lower_bound(r, j);
+        if (it == r.end() or *it != j) {
+            return nonzeros();
+        }
+        return offsets[i] + static_cast<std::size_t>(it - r.begin());
+    }
+
+    [[nodiscard]] constexpr auto contains(std::size_t i, std::size_t j) const
+        -> bool
+    {
+        return find(i, j) != nonzeros();
+    }
+
+    /// Pattern of the transpose, with `order[k]` the position in `indices`
+    /// of its `k`-th entry when `order` is given
+    [[nodiscard]] constexpr auto
+    transpose(std::vector<std::size_t>* order = nullptr) const
+        -> sparsity_pattern
+    {
+        auto t = sparsity_pattern{cols, rows};
+        t.offsets.assign(cols + 1, 0);
+        t.indices.resize(nonzeros());
+        for (const auto j : indices) {
+            ++t.offsets[j + 1];
+        }
+        for (std::size_t j{0}; j < cols; ++j) {
+            t.offsets[j + 1] += t.offsets[j];
+        }
+
+        auto next = std::vector<std::size_t>(t.offsets.begin(),
+                                             t.offsets.end() - 1);
+        if (order != nullptr) {
+            order->resize(nonzeros());
+        }
+        for (std::size_t i{0}; i < rows; ++i) {
+            for (auto k = offsets[i]; k < offsets[i + 1]; ++k) {
+                const auto tk = next[indices[k]]++;
+                t.indices[tk] = i;
+                if (order != nullptr) {
+                    (*order)[tk] = k;
+                }
+            }
+        }
+        return t;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator==(const sparsity_pattern&, const sparsity_pattern&)
+        -> bool = default;
+};
+
+/// Sparse matrix in compressed sparse row format, `values[k]` being the
+/// entry at the `k`-th position of `pattern`
+template <Arithmetic T>
+struct csr_matrix {
+    using entries_type = T;
+
+    sparsity_pattern pattern{};
+    std::vector<T> values{};
+
+    [[nodiscard]] constexpr auto rows() const -> std::size_t
+    {
+        return pattern.rows;
+    }
+    [[nodiscard]] constexpr auto cols() const -> std::size_t
+    {
+        return pattern.cols;
+    }
+    [[nodiscard]] constexpr auto nonzeros() const -> std::size_t
+    {
+        return pattern.nonzeros();
+    }
+
+    /// Entry `(i, j)`, zero outside the pattern
+    [[nodiscard]] constexpr auto
+    operator[](std::pair<std::size_t, std::size_t> indices) const -> T
+    {
+        const auto k = pattern.find(indices.first, indices.second);
+        return k == nonzeros() ? T{} : values[k];
+    }
+
+    friend auto operator<<(std::ostream& os, const csr_matrix& m)
+        -> std::ostream&
+    {
+        os << "[";
+        for (std::size_t i{0}; i < m.rows(); ++i) {
+            for (auto k = m.pattern.offsets[i]; k < m.pattern.offsets[i + 1];
+                 ++k) {
+                os << (k == 0 ? "" : ", ") << "(" << i << ", "
+                   << m.pattern.indices[k] << "): " << m.values[k];
+            }
+        }
+        os << "]";
+        return os;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator==(const csr_matrix&, const csr_matrix&) -> bool = default;
+};
+
+/// Sparse matrix in compressed sparse column format
+///
+/// `pattern` is the pattern of the transpose: the row indices of column `j`
+/// are `pattern.row(j)`. `values[k]` is the entry at the `k`-th position.
+template <Arithmetic T>
+struct csc_matrix {
+    using entries_type = T;
+
+    sparsity_pattern pattern{};
+    std::vector<T> values{};
+
+    [[nodiscard]] constexpr auto rows() const -> std::size_t
+    {
+        return pattern.cols;
+    }
+    [[nodiscard]] constexpr auto cols() const -> std::size_t
+    {
+        return pattern.rows;
+    }
+    [[nodiscard]] constexpr auto nonzeros() const -> std::size_t
+    {
+        return pattern.nonzeros();
+    }
+
+    /// Entry `(i, j)`, zero outside the pattern
+    [[nodiscard]] constexpr auto
+    operator[](std::pair<std::size_t, std::size_t> indices) const -> T
+    {
+        const auto k = pattern.find(indices.second, indices.first);
+        return k == nonzeros() ? T{} : values[k];
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator==(const csc_matrix&, const csc_matrix&) -> bool = default;
+};
+
+namespace detail {
+
+/// Matrix with the values of `m` in the order of the transposed pattern
+template <class R, class M>
+[[nodiscard]] constexpr auto transposed_storage(const M& m) -> R
+{
+    auto order = std::vector<std::size_t>{};
+    auto r = R{m.pattern.transpose(&order)};
+    r.values.resize(order.size());
+    for (std::size_t k{0}; k < order.size(); ++k) {
+        r.values[k] = m.values[order[k]];
+    }
+    return r;
+}
+
+}  // namespace detail
+
+template <Arithmetic T>
+[[nodiscard]] constexpr auto to_csc(const csr_matrix<T>& m) -> csc_matrix<T>
+{
+    return detail::transposed_storage<csc_matrix<T>>(m);
+}
+
+template <Arithmetic T>
+[[nodiscard]] constexpr auto to_csr(const csc_matrix<T>& m) -> csr_matrix<T>
+{
+    return detail::transposed_storage<csr_matrix<T>>(m);
+}
+
+/// Computes `m x`, the rows handed out in ranges by the scheduler `s`
+template <Arithmetic T, Vector V, Scheduler S = adaptive>
+    requires std::same_as<scalar_t<V>, T>
+[[nodiscard]] constexpr auto multiply(const csr_matrix<T>& m,
+                                      const V& x,
+                                      S s = {}) -> V
+{
+    auto y = detail::make_zero<V>(m.rows());
+    const auto set_rows = [&m, &x, &y](std::size_t first, std::size_t last) {
+        for (auto i = first; i < last; ++i) {
+            auto yi = T{};
+            for (auto k = m.pattern.offsets[i]; k < m.pattern.offsets[i + 1];
+                 ++k) {
+                yi += m.values[k] * x[m.pattern.indices[k]];
+            }
+            y[i] = yi;
+        }
+    };
+
+    detail::schedule(s, m.rows(), set_rows);
+    return y;
+}
+
+/// Computes `m x` serially, each column scattered into the result
+template <Arithmetic T, Vector V>
+    requires std::same_as<scalar_t<V>, T>
+[[nodiscard]] constexpr auto multiply(const csc_matrix<T>& m, const V& x) -> V
+{
+    auto y = detail::make_zero<V>(m.rows());
+    for (std::size_t j{0}; j < m.cols(); ++j) {
+        for (auto k = m.pattern.offsets[j]; k < m.pattern.offsets[j + 1];
+             ++k) {
+            y[m.pattern.indices[k]] += m.values[k] * x[j];
+        }
+    }
+    return y;
+}
+
+template <Arithmetic T, Vector V>
+    requires std::same_as<scalar_t<V>, T>
+[[nodiscard]] constexpr auto operator*(const csr_matrix<T>& m, const V& x)
+    -> V
+{
+    return multiply(m, x);
+}
+
+template <Arithmetic T, Vector V>
+    requires std::same_as<scalar_t<V>, T>
+[[nodiscard]] constexpr auto operator*(const csc_matrix<T>& m, const V& x)
+    -> V
+{
+    return multiply(m, x);
+}
+
+}  // namespace opt
@@ -0,0 +1,459 @@
+#pragma once
+
+#include "sparse_matrix.hpp"
+#include "stdx/cmath.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace opt {
+
+template <Arithmetic T>
+[[nodiscard]] constexpr auto trace(const csr_matrix<T>& m) -> T
+{
+    auto t = T{};
+    for (std::size_t i{0}; i < std::min(m.rows(), m.cols()); ++i) {
+        t += m[{i, i}];
+    }
+    return t;
+}
+
+template <Arithmetic T>
+[[nodiscard]] constexpr auto trace(const csc_matrix<T>& m) -> T
+{
+    auto t = T{};
+    for (std::size_t j{0}; j < std::min(m.rows(), m.cols()); ++j) {
+        t += m[{j, j}];
+    }
+    return t;
+}
+
+/// Order in which to eliminate the coordinates of the symmetric `pattern`
+/// to limit the fill of its Cholesky factor, `order[k]` being the
+/// coordinate eliminated `k`-th
+///
+/// Approximate minimum degree ordering: each step eliminates a coordinate
+/// with the smallest degree, on ties the one whose degree changed last, or
+/// else the smallest. The elimination graph is represented implicitly, each
+/// eliminated coordinate becoming an element that stands for the clique of
+/// its neighbors and absorbs the elements it was adjacent to. Degrees are
+/// replaced by the upper bounds of Amestoy, Davis and Duff, An Approximate
+/// Minimum Degree Ordering Algorithm, 1996. Supervariables are not
+/// detected.
+[[nodiscard]] inline auto minimum_degree_ordering(
+    const sparsity_pattern& pattern) -> std::vector<std::size_t>
+{
+    const auto n = pattern.rows;
+
+    // Uneliminated neighbors and adjacent elements of each coordinate, and
+    // coordinates of each element, indexed by the coordinate eliminated
+    auto variables = std::vector<std::vector<std::size_t>>(n);
+    auto elements = std::vector<std::vector<std::size_t>>(n);
+    auto members = std::vector<std::vector<std::size_t>>(n);
+    auto eliminated = std::vector<bool>(n);
+    auto absorbed = std::vector<bool>(n);
+
+    // Doubly linked lists of the uneliminated coordinates of each degree
+    auto degree = std::vector<std::size_t>(n);
+    auto head = std::vector<std::size_t>(n + 1, n);
+    auto next = std::vector<std::size_t>(n, n);
+    auto previous = std::vector<std::size_t>(n, n);
+    const auto insert = [&](std::size_t v) {
+        next[v] = head[degree[v]];
+        previous[v] = n;
+        if (next[v] != n) {
+            previous[next[v]] = v;
+        }
+        head[degree[v]] = v;
+    };
+    const auto remove = [&](std::size_t v) {
+        if (previous[v] == n) {
+            head[degree[v]] = next[v];
+        } else {
+            next[previous[v]] = next[v];
+        }
+        if (next[v] != n) {
+            previous[next[v]] = previous[v];
+        }
+    };
+
+    for (auto v = n; v-- > 0;) {
+        for (const auto w : pattern.row(v)) {
+            if (w != v) {
+                variables[v].push_back(w);
+            }
+        }
+        degree[v] = variables[v].size();
+        insert(v);
+    }
+
+    // in_clique[u] == p if u is a neighbor of the element p, and outside[e]
+    // is the number of coordinates of e outside of the last element once
+    // seen[e] == p
+    auto in_clique = std::vector<std::size_t>(n, n);
+    auto seen = std::vector<std::size_t>(n, n);
+    auto outside = std::vector<std::size_t>(n);
+
+    auto order = std::vector<std::size_t>{};
+    order.reserve(n);
+    auto min_degree = std::size_t{};
+    while (order.size() < n) {
+        while (head[min_degree] == n) {
+            ++min_degree;
+        }
+        const auto p = head[min_degree];
+        remove(p);
+        order.push_back(p);
+        eliminated[p] = true;
+        in_clique[p] = p;
+
+        // The new element joins the neighbors of p and of its elements
+        auto& clique = members[p];
+        const auto join = [&](std::size_t u) {
+            if (not eliminated[u] and in_clique[u] != p) {
+                in_clique[u] = p;
+                clique.push_back(u);
+            }
+        };
+        for (const auto u : variables[p]) {
+            join(u);
+        }
+        for (const auto e : elements[p]) {
+            for (const auto u : members[e]) {
+                join(u);
+            }
+            absorbed[e] = true;
+            members[e] = {};
+        }
+        variables[p] = {};
+        elements[p] = {};
+
+        // Neighbors now reached through p are dropped from the lists
+        for (const auto u : clique) {
+            std::erase_if(variables[u], [&](std::size_t w) {
+                return eliminated[w] or in_clique[w] == p;
+            });
+            std::erase_if(elements[u],
+                          [&absorbed](std::size_t e) { return absorbed[e]; });
+
+            for (const auto e : elements[u]) {
+                if (seen[e] != p) {
+                    seen[e] = p;
+                    outside[e] = members[e].size();
+                }
+                --outside[e];
+            }
+            elements[u].push_back(p);
+        }
+
+        const auto remaining = n - order.size();
+        for (const auto u : clique) {
+            auto bound = variables[u].size() + clique.size() - 1;
+            for (const auto e : elements[u]) {
+                if (e != p) {
+                    bound += outside[e];
+                }
+            }
+
+            remove(u);
+            degree[u] = std::min(
+                {bound, degree[u] + clique.size() - 1, remaining - 1});
+            insert(u);
+            min_degree = std::min(min_degree, degree[u]);
+        }
+    }
+    return order;
+}
+
+/// Symbolic Cholesky factorization of the matrices with a symmetric
+/// pattern, reused as long as only their values change
+///
+/// The rows and columns are permuted by a fill-reducing ordering before
+/// factorization, `P A Pᵀ = L Lᵀ` with `(P A Pᵀ)[k, l] = A[permutation[k],
+/// permutation[l]]`.
+struct cholesky_symbolic {
+    std::vector<std::size_t> permutation{};
+    /// Parent of each column in the elimination tree, `size()` for roots
+    std::vector<std::size_t> parent{};
+    /// Pattern of `L` in compressed sparse column format, the diagonal entry
+    /// first in each column
+    sparsity_pattern factor{};
+
+    /// Entries of the upper triangle of `P A Pᵀ`, by column, as the row and
+    /// the position in the values of `A`, `none` for a missing diagonal
+    sparsity_pattern upper{};
+    std::vector<std::size_t> sources{};
+
+    static constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {
+        return permutation.size();
+    }
+};
+
+namespace detail {
+
+/// Nonzero pattern of row `k` of `L`, without the diagonal, written to
+/// `stack[top, n)` in topological order, and returns `top`
+///
+/// Walks up the elimination tree from each entry of column `k` of the upper
+/// triangle, until a column already visited for `k`. See Davis, Direct
+/// Methods for Sparse Linear Systems, section 4.1.
+constexpr auto elimination_reach(const cholesky_symbolic& s,
+                                 std::size_t k,
+                                 std::vector<std::size_t>& stack,
+                                 std::vector<std::size_t>& mark) -> std::size_t
+{
+    const auto n = s.size();
+    auto top = n;
+    mark[k] = k;
+    for (auto i : s.upper.row(k)) {
+        auto length = top;
+        for (; mark[i] != k; i = s.parent[i]) {
+            stack[--length] = i;
+            mark[i] = k;
+        }
+        // The path was pushed in reverse, move it to the top in order
+        std::reverse(stack.begin() + static_cast<std::ptrdiff_t>(length),
+                     stack.begin() + static_cast<std::ptrdiff_t>(top));
+        top = length;
+    }
+    return top;
+}
+
+}  // namespace detail
+
+/// Computes the symbolic Cholesky factorization of the matrices with the
+/// symmetric `pattern`, after a `minimum_degree_ordering` of the coordinates
+[[nodiscard]] inline auto analyze_cholesky(const sparsity_pattern& pattern)
+    -> cholesky_symbolic
+{
+    constexpr auto none = cholesky_symbolic::none;
+    const auto n = pattern.rows;
+
+    auto s = cholesky_symbolic{minimum_degree_ordering(pattern)};
+    auto inverse = std::vector<std::size_t>(n);
+    for (std::size_t k{0}; k < n; ++k) {
+        inverse[s.permutation[k]] = k;
+    }
+
+    // Upper triangle of P A Pᵀ, with the diagonal always present so that
+    // it can be shifted
+    auto entries = std::vector<std::pair<std::size_t, std::size_t>>{};
+    for (std::size_t k{0}; k < n; ++k) {
+        const auto i = s.permutation[k];
+        entries.emplace_back(k, k);
+        for (const auto j : pattern.row(i)) {
+            if (inverse[j] < k) {
+                entries.emplace_back(k, inverse[j]);
+            }
+        }
+    }
+    s.upper = sparsity_pattern::from_entries(n, n, std::move(entries));
+    s.sources.assign(s.upper.nonzeros(), none);
+    for (std::size_t k{0}; k < n; ++k) {
+        const auto i = s.permutation[k];
+        for (auto q = pattern.offsets[i]; q < pattern.offsets[i + 1]; ++q) {
+            const auto l = inverse[pattern.indices[q]];
+            if (l <= k) {
+                s.sources[s.upper.find(k, l)] = q;
+            }
+        }
+    }
+
+    // Elimination tree, with path compression through `ancestor`
+    s.parent.assign(n, n);
+    auto ancestor = std::vector<std::size_t>(n, n);
+    for (std::size_t k{0}; k < n; ++k) {
+        for (auto i : s.upper.row(k)) {
+            while (i < k) {
+                const auto next = ancestor[i];
+                ancestor[i] = k;
+                if (next == n) {
+                    s.parent[i] = k;
+                    break;
+                }
+                i = next;
+            }
+        }
+    }
+
+    // Columns of L, each row k adding an entry to the columns of its reach,
+    // counted first and then filled in increasing order of the rows
+    auto stack = std::vector<std::size_t>(n);
+    auto mark = std::vector<std::size_t>(n, none);
+    const auto for_each_entry = [&s, &stack, &mark, n](auto f) {
+        std::ranges::fill(mark, cholesky_symbolic::none);
+        for (std::size_t k{0}; k < n; ++k) {
+            f(k, k);
+            for (auto t = detail::elimination_reach(s, k, stack, mark); t < n;
+                 ++t) {
+                f(stack[t], k);
+            }
+        }
+    };
+
+    auto& l = s.factor;
+    l = sparsity_pattern{n, n};
+    l.offsets.assign(n + 1, 0);
+    for_each_entry([&l](std::size_t j, std::size_t) { ++l.offsets[j + 1]; });
+    for (std::size_t j{0}; j < n; ++j) {
+        l.offsets[j + 1] += l.offsets[j];
+    }
+    l.indices.resize(l.offsets[n]);
+    auto next =
+        std::vector<std::size_t>(l.offsets.begin(), l.offsets.end() - 1);
+    for_each_entry([&l, &next](std::size_t j, std::size_t i) {
+        l.indices[next[j]++] = i;
+    });
+    return s;
+}
+
+/// Numeric Cholesky factor for the symbolic factorization `symbolic`, with
+/// the workspace of the factorization
+///
+/// Factorizing again a matrix with the same pattern doesn't allocate.
+template <Arithmetic T>
+struct sparse_cholesky {
+    cholesky_symbolic symbolic{};
+    /// Values of `L`, in the order of `symbolic.factor`
+    std::vector<T> values{};
+
+    std::vector<T> work{};
+    std::vector<std::size_t> next{};
+    std::vector<std::size_t> stack{};
+    std::vector<std::size_t> mark{};
+};
+
+/// Factorizes `a + shift I` into `sparse_cholesky` factor `f`, for `a` with
+/// the pattern analyzed in `f.symbolic`
+///
+/// Up-looking factorization, computing row `k` of `L` by a sparse triangular
+/// solve with the rows above. Returns `false`, leaving `f` partially
+/// factorized, if the matrix is not positive definite.
+template <Arithmetic T>
+[[nodiscard]] constexpr auto
+cholesky(const csr_matrix<T>& a, sparse_cholesky<T>& f, T shift = T{})
+    -> bool
+{
+    const auto& s = f.symbolic;
+    const auto n = s.size();
+    const auto& l = s.factor;
+
+    f.values.resize(l.nonzeros());
+    f.work.assign(n, T{});
+    f.next.assign(l.offsets.begin(), l.offsets.end() - 1);
+    f.stack.resize(n);
+    f.mark.assign(n, cholesky_symbolic::none);
+
+    for (std::size_t k{0}; k < n; ++k) {
+        const auto top = detail::elimination_reach(s, k, f.stack, f.mark);
+
+        // Column k of the upper triangle of P A Pᵀ
+        for (auto q = s.upper.offsets[k]; q < s.upper.offsets[k + 1]; ++q) {
+            const auto source = s.sources[q];
+            f.work[s.upper.indices[q]] =
+                source == cholesky_symbolic::none ? T{} : a.values[source];
+        }
+        auto d = f.work[k] + shift;
+        f.work[k] = T{};
+
+        for (auto t = top; t < n; ++t) {
+            const auto i = f.stack[t];
+            const auto lki = f.work[i] / f.values[l.offsets[i]];
+            f.work[i] = T{};
+            for (auto p = l.offsets[i] + 1; p < f.next[i]; ++p) {
+                f.work[l.indices[p]] -= f.values[p] * lki;
+            }
+            d -= lki * lki;
+            f.values[f.next[i]++] = lki;
+        }
+
+        if (not(d > T{})) {
+            return false;
+        }
+        f.values[f.next[k]++] = stdx::sqrt(d);
+    }
+    return true;
+}
+
+/// Solves `A x = b` for the factor computed by `cholesky`
+template <Arithmetic T, Vector V>
+    requires std::same_as<scalar_t<V>, T>
+[[nodiscard]] constexpr auto cholesky_solve(const sparse_cholesky<T>& f,
+                                            const V& b) -> V
+{
+    const auto& s = f.symbolic;
+    const auto& l = s.factor;
+    const auto n = s.size();
+
+    auto x = std::vector<T>(n);
+    for (std::size_t k{0}; k < n; ++k) {
+        x[k] = b[s.permutation[k]];
+    }
+    for (std::size_t j{0}; j < n; ++j) {
+        x[j] /= f.values[l.offsets[j]];
+        for (auto p = l.offsets[j] + 1; p < l.offsets[j + 1]; ++p) {
+            x[l.indices[p]] -= f.values[p] * x[j];
+        }
+    }
+    for (auto j = n; j-- > 0;) {
+        for (auto p = l.offsets[j] + 1; p < l.offsets[j + 1]; ++p) {
+            x[j] -= f.values[p] * x[l.indices[p]];
+        }
+        x[j] /= f.values[l.offsets[j]];
+    }
+
+    auto r = detail::make_zero<V>(n);
+    for (std::size_t k{0}; k < n; ++k) {
+        r[s.permutation[k]] = x[k];
+    }
+    return r;
+}
+
+/// Factorizes `a + tau I` into `f` with `cholesky`, for the smallest `tau`
+/// found making it positive definite, and returns `tau`
+///
+/// Same strategy as the dense `modified_cholesky`, returning NaN with `f`
+/// left unusable if it fails.
+template <Arithmetic T>
+constexpr auto modified_cholesky(const csr_matrix<T>& a,
+                                 sparse_cholesky<T>& f,
+                                 T beta = T{1e-3F},
+                                 std::size_t max_shifts = 64) -> T
+{
+    const auto n = a.rows();
+    if (n == 0) {
+        return T{};
+    }
+
+    auto min_diagonal = a[{0, 0}];
+    auto max_diagonal = stdx::abs(a[{0, 0}]);
+    for (std::size_t i{1}; i < n; ++i) {
+        min_diagonal = std::min(min_diagonal, a[{i, i}]);
+        max_diagonal = std::max(max_diagonal, stdx::abs(a[{i, i}]));
+    }
+    for (std::size_t i{0}; i < n; ++i) {
+        if (not(stdx::abs(a[{i, i}]) <= std::numeric_limits<T>::max())) {
+            return std::numeric_limits<T>::quiet_NaN();
+        }
+    }
+
+    const auto shift = beta * std::max(max_diagonal, T{1});
+    auto tau = min_diagonal > T{} ? T{} : shift - min_diagonal;
+    for (std::size_t k{0};
+         k <= max_shifts and tau <= std::numeric_limits<T>::max();
+         ++k) {
+        if (cholesky(a, f, tau)) {
+            return tau;
+        }
+        tau = std::max(2 * tau, shift);
+    }
+    return std::numeric_limits<T>::quiet_NaN();
+}
+
+}  // namespace opt
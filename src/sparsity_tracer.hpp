@@ -0,0 +1,179 @@
+#pragma once
+
+#include "concepts.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace opt {
+namespace impl {
+
+/// Number recording which coordinates its value depends on, and which
+/// pairs of coordinates may have a nonzero second derivative
+///
+/// The value is computed as well, so branches on it take the same path as
+/// with real numbers and the pattern found is that of the Hessian at the
+/// point evaluated. The pattern is conservative: a product of two values
+/// depending on `x` and `y` is assumed nonlinear in `(x, y)` even if terms
+/// cancel.
+template <Arithmetic T>
+struct sparsity_tracer {
+    using index_pair = std::pair<std::size_t, std::size_t>;
+
+    T real{};
+    /// Sorted coordinates the value depends on
+    std::vector<std::size_t> gradient{};
+    /// Sorted pairs `(i, j)`, `i <= j`, of the upper triangle of the Hessian
+    std::vector<index_pair> hessian{};
+
+    /// Tracer of coordinate `i` with value `value`
+    [[nodiscard]] static constexpr auto variable(T value, std::size_t i)
+        -> sparsity_tracer
+    {
+        return {value, {i}, {}};
+    }
+
+    /// Same dependencies as `x`, with value `value` and all the second
+    /// derivatives of a nonlinear function of `x`
+    [[nodiscard]] static constexpr auto nonlinear(const sparsity_tracer& x,
+                                                  T value) -> sparsity_tracer
+    {
+        return {value,
+                x.gradient,
+                with_products(x.hessian, x.gradient, x.gradient)};
+    }
+
+  private:
+    template <class U>
+    [[nodiscard]] static constexpr auto merge(const std::vector<U>& x,
+                                              const std::vector<U>& y)
+        -> std::vector<U>
+    {
+        auto r = std::vector<U>{};
+        r.reserve(x.size() + y.size());
+        std::ranges::set_union(x, y, std::back_inserter(r));
+        return r;
+    }
+
+    /// `h` with the pairs of an element of `x` and an element of `y`
+    [[nodiscard]] static constexpr auto
+    with_products(const std::vector<index_pair>& h,
+                  const std::vector<std::size_t>& x,
+                  const std::vector<std::size_t>& y) -> std::vector<index_pair>
+    {
+        auto p = std::vector<index_pair>{};
+        p.reserve(x.size() * y.size());
+        for (const auto i : x) {
+            for (const auto j : y) {
+                p.emplace_back(std::min(i, j), std::max(i, j));
+            }
+        }
+        std::ranges::sort(p);
+        const auto repeated = std::ranges::unique(p);
+        p.erase(repeated.begin(), repeated.end());
+        return merge(h, p);
+    }
+
+    [[nodiscard]] static constexpr auto
+    linear(const sparsity_tracer& x, const sparsity_tracer& y, T value)
+        -> sparsity_tracer
+    {
+        return {value,
+                merge(x.gradient, y.gradient),
+                merge(x.hessian, y.hessian)};
+    }
+
+  public:
+    [[nodiscard]] friend constexpr auto
+    operator+(const sparsity_tracer& x, const sparsity_tracer& y)
+        -> sparsity_tracer
+    {
+        return linear(x, y, x.real + y.real);
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator-(const sparsity_tracer& x, const sparsity_tracer& y)
+        -> sparsity_tracer
+    {
+        return linear(x, y, x.real - y.real);
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator*(const sparsity_tracer& x, const sparsity_tracer& y)
+        -> sparsity_tracer
+    {
+        auto r = linear(x, y, x.real * y.real);
+        r.hessian = with_products(r.hessian, x.gradient, y.gradient);
+        return r;
+    }
+
+    /// `x / y` is nonlinear in `y` and bilinear in `(x, y)`
+    [[nodiscard]] friend constexpr auto
+    operator/(const sparsity_tracer& x, const sparsity_tracer& y)
+        -> sparsity_tracer
+    {
+        auto r = linear(x, y, x.real / y.real);
+        r.hessian = with_products(r.hessian, x.gradient, y.gradient);
+        r.hessian = with_products(r.hessian, y.gradient, y.gradient);
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto operator-(const sparsity_tracer& x)
+        -> sparsity_tracer
+    {
+        return {-x.real, x.gradient, x.hessian};
+    }
+
+    constexpr auto operator+=(const sparsity_tracer& x) -> sparsity_tracer&
+    {
+        return *this = *this + x;
+    }
+    constexpr auto operator-=(const sparsity_tracer& x) -> sparsity_tracer&
+    {
+        return *this = *this - x;
+    }
+    constexpr auto operator*=(const sparsity_tracer& x) -> sparsity_tracer&
+    {
+        return *this = *this * x;
+    }
+    constexpr auto operator/=(const sparsity_tracer& x) -> sparsity_tracer&
+    {
+        return *this = *this / x;
+    }
+
+    friend auto operator<<(std::ostream& os, const sparsity_tracer& x)
+        -> std::ostream&
+    {
+        os << "(" << x.real << ", {";
+        for (std::size_t k{0}; k < x.gradient.size(); ++k) {
+            os << (k == 0 ? "" : ", ") << x.gradient[k];
+        }
+        os << "}, {";
+        for (std::size_t k{0}; k < x.hessian.size(); ++k) {
+            os << (k == 0 ? "" : ", ") << "(" << x.hessian[k].first << ", "
+               << x.hessian[k].second << ")";
+        }
+        os << "})";
+        return os;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator<(const sparsity_tracer& x, const sparsity_tracer& y) -> bool
+    {
+        return x.real < y.real;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator==(const sparsity_tracer& x, const sparsity_tracer& y)
+        -> bool = default;
+};
+
+}  // namespace impl
+
+using impl::sparsity_tracer;
+
+}  // namespace opt
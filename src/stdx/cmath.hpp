@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <type_traits>
+
+namespace opt::stdx {
+
+/// `std::abs`, usable in constant expressions
+template <std::floating_point T>
+[[nodiscard]] constexpr auto abs(T x) -> T
+{
+    return x < T{} ? -x : x;
+}
+
+/// `std::sqrt`, usable in constant expressions
+///
+/// Computes Newton iterations during constant evaluation. Negative arguments
+/// give zero instead of NaN.
+template <std::floating_point T>
+[[nodiscard]] constexpr auto sqrt(T x) -> T
+{
+    if (not std::is_constant_evaluated()) {
+        return std::sqrt(x);
+    }
+    if (not(x > T{})) {
+        return T{};
+    }
+
+    // Newton iterations from above decrease monotonically
+    auto r = x > T{1} ? x : T{1};
+    while (true) {
+        const auto next = (r + x / r) / 2;
+        if (not(next < r)) {
+            return r;
+        }
+        r = next;
+    }
+}
+
+}  // namespace opt::stdx
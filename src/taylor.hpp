@@ -0,0 +1,275 @@
+#pragma once
+
+#include "concepts.hpp"
+#include "dualnumbers.hpp"
+
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <utility>
+
+namespace opt {
+namespace impl {
+
+/// Truncated Taylor series of order `K` in a single variable `t`
+///
+/// `coefficients[k]` is the `k`-th derivative at `t = 0` divided by `k!`.
+/// Arithmetic on the series propagates all derivatives up to order `K`
+/// exactly, multiplication and division in `O(K^2)`.
+template <Arithmetic T, std::size_t K>
+struct taylor {
+    static constexpr auto order = K;
+
+    std::array<T, K + 1> coefficients{};
+
+    /// Series of `value + direction t`
+    [[nodiscard]] static constexpr auto variable(T value, T direction = T{1})
+        -> taylor
+    {
+        auto r = taylor{value};
+        if constexpr (K > 0) {
+            r.coefficients[1] = direction;
+        }
+        return r;
+    }
+
+    /// `k`-th derivative at `t = 0`
+    [[nodiscard]] constexpr auto derivative(std::size_t k) const -> T
+    {
+        auto r = coefficients.at(k);
+        auto n = T{1};
+        for (std::size_t i{1}; i <= k; ++i, n += T{1}) {
+            r *= n;
+        }
+        return r;
+    }
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+
+    [[nodiscard]] friend constexpr auto
+    operator+(const taylor& x, const taylor& y) -> taylor
+    {
+        auto r = taylor{};
+        for (std::size_t k{0}; k <= K; ++k) {
+            r.coefficients[k] = x.coefficients[k] + y.coefficients[k];
+        }
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator-(const taylor& x, const taylor& y) -> taylor
+    {
+        auto r = taylor{};
+        for (std::size_t k{0}; k <= K; ++k) {
+            r.coefficients[k] = x.coefficients[k] - y.coefficients[k];
+        }
+        return r;
+    }
+
+    /// Cauchy product, truncated at order `K`
+    [[nodiscard]] friend constexpr auto
+    operator*(const taylor& x, const taylor& y) -> taylor
+    {
+        auto r = taylor{};
+        for (std::size_t k{0}; k <= K; ++k) {
+            for (std::size_t j{0}; j <= k; ++j) {
+                r.coefficients[k] += x.coefficients[j] * y.coefficients[k - j];
+            }
+        }
+        return r;
+    }
+
+    /// Solves `r * y = x` for the coefficients of `r` in increasing order
+    [[nodiscard]] friend constexpr auto
+    operator/(const taylor& x, const taylor& y) -> taylor
+    {
+        auto r = taylor{};
+        for (std::size_t k{0}; k <= K; ++k) {
+            auto c = x.coefficients[k];
+            for (std::size_t j{1}; j <= k; ++j) {
+                c -= y.coefficients[j] * r.coefficients[k - j];
+            }
+            r.coefficients[k] = c / y.coefficients[0];
+        }
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto operator-(const taylor& x) -> taylor
+    {
+        auto r = taylor{};
+        for (std::size_t k{0}; k <= K; ++k) {
+            r.coefficients[k] = -x.coefficients[k];
+        }
+        return r;
+    }
+
+    // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+
+    constexpr auto operator+=(const taylor& x) -> taylor&
+    {
+        return *this = *this + x;
+    }
+    constexpr auto operator-=(const taylor& x) -> taylor&
+    {
+        return *this = *this - x;
+    }
+    constexpr auto operator*=(const taylor& x) -> taylor&
+    {
+        return *this = *this * x;
+    }
+    constexpr auto operator/=(const taylor& x) -> taylor&
+    {
+        return *this = *this / x;
+    }
+
+    friend auto operator<<(std::ostream& os, const taylor& x) -> std::ostream&
+    {
+        os << "(";
+        for (std::size_t k{0}; k <= K; ++k) {
+            os << (k == 0 ? "" : ", ") << x.coefficients.at(k);
+        }
+        os << ")";
+        return os;
+    }
+
+    /// Compares the values at `t = 0`
+    [[nodiscard]] friend constexpr auto
+    operator<(const taylor& x, const taylor& y) -> bool
+    {
+        return x.coefficients[0] < y.coefficients[0];
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator==(const taylor& x, const taylor& y) -> bool = default;
+
+    [[nodiscard]] friend constexpr auto
+    close_to(const taylor& x, const taylor& y, const T& tol) -> bool
+    {
+        constexpr auto abs = [](auto x) {
+            if (x < decltype(x){}) {
+                return -x;
+            }
+
+            return x;
+        };
+
+        for (std::size_t k{0}; k <= K; ++k) {
+            if (not(abs(x.coefficients.at(k) - y.coefficients.at(k)) < tol)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Recurrences for the series of elementary functions, given the value of the
+// function at the constant term of the argument. Each derives from a linear
+// differential equation satisfied by the function, e.g. y' = x' y for
+// y = exp(x), and uses the coefficients `k x[k]` of the derivative of the
+// argument, computed once per call.
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+
+/// `1, 2, ..., K` converted to `T`, with index 0 unused
+template <class T, std::size_t K>
+inline constexpr auto integers = [] {
+    auto r = std::array<T, K + 1>{};
+    for (std::size_t k{1}; k <= K; ++k) {
+        r[k] = r[k - 1] + T{1};
+    }
+    return r;
+}();
+
+/// Coefficients `k x[k]` of the derivative of `x`, shifted by one order
+template <class T, std::size_t K>
+constexpr auto derivative_terms(const taylor<T, K>& x) -> std::array<T, K + 1>
+{
+    auto r = std::array<T, K + 1>{};
+    for (std::size_t k{1}; k <= K; ++k) {
+        r[k] = integers<T, K>[k] * x.coefficients[k];
+    }
+    return r;
+}
+
+/// `exp(x)` given `e0 = exp(x[0])`
+template <class T, std::size_t K>
+constexpr auto exp_series(const taylor<T, K>& x, T e0) -> taylor<T, K>
+{
+    const auto dx = derivative_terms(x);
+
+    auto y = taylor<T, K>{e0};
+    for (std::size_t k{1}; k <= K; ++k) {
+        auto c = T{};
+        for (std::size_t j{1}; j <= k; ++j) {
+            c += dx[j] * y.coefficients[k - j];
+        }
+        y.coefficients[k] = c / integers<T, K>[k];
+    }
+    return y;
+}
+
+/// `log(x)` given `l0 = log(x[0])`
+template <class T, std::size_t K>
+constexpr auto log_series(const taylor<T, K>& x, T l0) -> taylor<T, K>
+{
+    // x y' = x', with the terms k y[k] kept as they are computed
+    auto y = taylor<T, K>{l0};
+    auto dy = std::array<T, K + 1>{};
+    for (std::size_t k{1}; k <= K; ++k) {
+        auto c = T{};
+        for (std::size_t j{1}; j < k; ++j) {
+            c += dy[j] * x.coefficients[k - j];
+        }
+        dy[k] = (integers<T, K>[k] * x.coefficients[k] - c) /
+                x.coefficients[0];
+        y.coefficients[k] = dy[k] / integers<T, K>[k];
+    }
+    return y;
+}
+
+/// `sin(x)` and `cos(x)` given `s0 = sin(x[0])` and `c0 = cos(x[0])`
+template <class T, std::size_t K>
+constexpr auto sin_cos_series(const taylor<T, K>& x, T s0, T c0)
+    -> std::pair<taylor<T, K>, taylor<T, K>>
+{
+    const auto dx = derivative_terms(x);
+
+    auto s = taylor<T, K>{s0};
+    auto c = taylor<T, K>{c0};
+    for (std::size_t k{1}; k <= K; ++k) {
+        auto ds = T{};
+        auto dc = T{};
+        for (std::size_t j{1}; j <= k; ++j) {
+            ds += dx[j] * c.coefficients[k - j];
+            dc -= dx[j] * s.coefficients[k - j];
+        }
+        s.coefficients[k] = ds / integers<T, K>[k];
+        c.coefficients[k] = dc / integers<T, K>[k];
+    }
+    return {s, c};
+}
+
+/// `x` raised to a constant `a` given `p0 = x[0]^a`, for `x[0] != 0`
+template <class T, std::size_t K>
+constexpr auto pow_series(const taylor<T, K>& x, T a, T p0) -> taylor<T, K>
+{
+    // x y' = a x' y
+    auto y = taylor<T, K>{p0};
+    for (std::size_t k{1}; k <= K; ++k) {
+        auto c = T{};
+        for (std::size_t j{1}; j <= k; ++j) {
+            const auto w = a * integers<T, K>[j] - integers<T, K>[k - j];
+            c += w * x.coefficients[j] * y.coefficients[k - j];
+        }
+        y.coefficients[k] = c / (integers<T, K>[k] * x.coefficients[0]);
+    }
+    return y;
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+
+}  // namespace impl
+
+using impl::taylor;
+
+}  // namespace opt
@@ -0,0 +1,349 @@
+#pragma once
+
+#include "src/concepts.hpp"
+#include "src/convopt.hpp"
+#include "src/expression.hpp"
+#include "src/matrix.hpp"
+#include "src/matrix_ops.hpp"
+#include "src/solver_options.hpp"
+#include "src/spaces.hpp"
+#include "src/stdx/cmath.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace opt {
+
+/// Radius of the trust region and rule for accepting steps
+template <class T>
+struct trust_region_options {
+    T initial_radius{1};
+    T max_radius{1e3F};
+    /// Steps are accepted if they lower the cost by more than `eta` times
+    /// the decrease predicted by the model
+    T eta{0.125F};
+};
+
+/// Buffers of `trust_region_dogleg`, reused by every solve
+template <Point P>
+    requires TupleSizable<P>
+struct dogleg_workspace {
+    P trial{};
+    distance_t<P> step{};
+    /// Hessian at the current point and the Cholesky factor of its
+    /// positive definite modification
+    matrix<distance_t<P>, std::tuple_size_v<P>> hessian{};
+    matrix<distance_t<P>, std::tuple_size_v<P>> factor{};
+    /// Minimizers of the model, unconstrained and along the gradient
+    distance_t<P> newton{};
+    distance_t<P> cauchy{};
+};
+
+/// Buffers of `trust_region_steihaug`, allocated for the dimension of `x`
+/// and reused by every solve of that dimension
+template <Point P>
+struct steihaug_workspace {
+    P trial;
+    distance_t<P> step;
+    /// Product of the Hessian with `step`
+    distance_t<P> hessian_step;
+    /// Residual `H step + g` of the conjugate gradient method, its search
+    /// direction and the product of the Hessian with it
+    distance_t<P> residual;
+    distance_t<P> direction;
+    distance_t<P> hessian_direction;
+
+    constexpr explicit steihaug_workspace(const P& x)
+        : trial{x},
+          step{detail::make_zero<distance_t<P>>(dimension(x))},
+          hessian_step{step},
+          residual{step},
+          direction{step},
+          hessian_direction{step}
+    {}
+};
+
+namespace detail {
+
+/// Decrease of the quadratic model for a step, and whether the step ends on
+/// the boundary of the trust region
+template <class T>
+struct model_step {
+    T decrease{};
+    bool boundary{};
+};
+
+/// Largest `tau` with `|s + tau d| <= radius`, for `s` inside the region
+template <Vector V>
+[[nodiscard]] constexpr auto
+boundary_step(const V& s, const V& d, scalar_t<V> radius) -> scalar_t<V>
+{
+    const auto a = norm(d);
+    const auto b = dot(s, d);
+    const auto c = norm(s) - radius * radius;
+    return (-b + stdx::sqrt(b * b - a * c)) / a;
+}
+
+/// Minimizes `cost` from `x` with a trust-region method, computing the step
+/// of each iteration into `step` with `solve(x, g, radius, moved)`
+///
+/// `moved` is `false` if `x` is unchanged since the previous call, after a
+/// rejected step. `trial` receives the candidate points.
+template <Point P, Cost<P> F, class Solve>
+constexpr auto trust_region(P x,
+                            F cost,
+                            P& trial,
+                            const distance_t<P>& step,
+                            const solver_options<scalar_t<P>>& options,
+                            const trust_region_options<scalar_t<P>>& region,
+                            Solve solve) -> solve_result<P>
+{
+    using T = scalar_t<P>;
+
+    const auto stop = detail::stop_criteria{options};
+
+    auto r = solve_result<P>{};
+    r.value = cost(x);
+    r.gradient = gradient(x, cost);
+    r.x = std::move(x);
+    r.cost_evaluations = 1;
+    r.gradient_evaluations = 1;
+
+    auto radius = region.initial_radius;
+    auto moved = true;
+    auto decrease = T{};
+    auto step_length = T{};
+    for (;;) {
+        if (const auto reason = stop(r, decrease, step_length, moved)) {
+            r.reason = *reason;
+            break;
+        }
+
+        const auto m = solve(std::as_const(r.x), r.gradient, radius, moved);
+        ++r.iterations;
+        if (not(m.decrease > T{})) {
+            r.reason = stop_reason::trust_region_failed;
+            break;
+        }
+
+        assign(trial, lazy(r.x) + lazy(step));
+        const auto value = cost(std::as_const(trial));
+        ++r.cost_evaluations;
+
+        const auto rho = (r.value - value) / m.decrease;
+        const auto length = stdx::sqrt(norm(step));
+        if (not(rho >= T{0.25F})) {
+            radius = T{0.25F} * length;
+        } else if (rho > T{0.75F} and m.boundary) {
+            radius = std::min(T{2} * radius, region.max_radius);
+        }
+
+        moved = rho > region.eta;
+        if (moved) {
+            decrease = r.value - value;
+            step_length = length;
+            std::swap(r.x, trial);
+            r.value = value;
+            r.gradient = gradient(r.x, cost);
+            ++r.gradient_evaluations;
+        } else if (not(radius > std::numeric_limits<T>::epsilon() *
+                                    region.initial_radius)) {
+            r.reason = stop_reason::trust_region_failed;
+            break;
+        }
+    }
+
+    return r;
+}
+
+}  // namespace detail
+
+/// Minimizes `cost` from `x` with the dogleg trust-region method, until one
+/// of the criteria of `options` is met
+///
+/// The Hessian from `hessian` is made positive definite with
+/// `modified_cholesky`, and evaluated and factorized once per accepted step.
+/// Each step follows the path from the origin to the minimizer of the model
+/// along the gradient, then to the Newton step, up to the boundary of the
+/// trust region. The buffers of `w` are reused, so a solve allocates no
+/// memory. See Nocedal and Wright, Numerical Optimization, section 4.1.
+///
+/// Ends with `stop_reason::trust_region_failed` if the Hessian can't be
+/// factorized.
+template <Point P, Cost<P> F>
+    requires TupleSizable<P>
+constexpr auto
+trust_region_dogleg(P x,
+                    F cost,
+                    dogleg_workspace<P>& w,
+                    solver_options<scalar_t<P>> options = {},
+                    trust_region_options<scalar_t<P>> region = {})
+    -> solve_result<P>
+{
+    using T = scalar_t<P>;
+
+    auto shift = T{};
+    const auto product = [&w, &shift](const distance_t<P>& v) {
+        return w.hessian * v + shift * v;
+    };
+
+    const auto solve = [&w, &cost, &shift, &product](const P& y,
+                           const distance_t<P>& g,
+                           T radius,
+                           bool moved) {
+        if (moved) {
+            w.hessian = hessian(y, cost);
+            w.factor = w.hessian;
+            shift = modified_cholesky(w.factor);
+            if (not(shift >= T{})) {
+                return detail::model_step<T>{};
+            }
+            w.newton = -cholesky_solve(w.factor, g);
+
+            const auto g2 = norm(g);
+            assign(w.cauchy, (-g2 / dot(g, product(g))) * lazy(g));
+        }
+
+        auto boundary = true;
+        if (norm(w.newton) <= radius * radius) {
+            w.step = w.newton;
+            boundary = false;
+        } else if (norm(w.cauchy) >= radius * radius) {
+            assign(w.step, (-radius / stdx::sqrt(norm(g))) * lazy(g));
+        } else {
+            assign(w.step, lazy(w.newton) - lazy(w.cauchy));
+            const auto tau = detail::boundary_step(w.cauchy, w.step, radius);
+            assign(w.step, lazy(w.cauchy) + tau * lazy(w.step));
+        }
+
+        return detail::model_step<T>{
+            -(dot(g, w.step) + T{0.5F} * dot(w.step, product(w.step))),
+            boundary};
+    };
+
+    return detail::trust_region(
+        std::move(x), cost, w.trial, w.step, options, region, solve);
+}
+
+/// Minimizes `cost` from `x` with the dogleg trust-region method, on a
+/// workspace of its own
+template <Point P, Cost<P> F>
+    requires TupleSizable<P>
+constexpr auto
+trust_region_dogleg(P x,
+                    F cost,
+                    solver_options<scalar_t<P>> options = {},
+                    trust_region_options<scalar_t<P>> region = {})
+    -> solve_result<P>
+{
+    auto w = dogleg_workspace<P>{};
+    return trust_region_dogleg(std::move(x), cost, w, options, region);
+}
+
+/// Minimizes `cost` from `x` with the Steihaug-CG trust-region method, until
+/// one of the criteria of `options` is met
+///
+/// Each step minimizes the model with the conjugate gradient method on the
+/// products of `hessian_vector_product`, stopping on the boundary of the
+/// trust region, along a direction of nonpositive curvature, or once the
+/// residual is below `min(1/2, sqrt(|g|)) |g|`. The Hessian is never formed
+/// and points of dynamic size are supported. See Nocedal and Wright,
+/// Numerical Optimization, algorithm 7.2.
+///
+/// The vectors of the method are the buffers of `w`, which must have the
+/// dimension of `x`. Only the evaluations of the derivatives allocate,
+/// on points of dynamic size.
+template <Point P, Cost<P> F>
+constexpr auto
+trust_region_steihaug(P x,
+                      F cost,
+                      steihaug_workspace<P>& w,
+                      solver_options<scalar_t<P>> options = {},
+                      trust_region_options<scalar_t<P>> region = {})
+    -> solve_result<P>
+{
+    using T = scalar_t<P>;
+
+    assert(dimension(w.step) == dimension(x));
+
+    const auto solve = [&w, &cost](const P& y,
+                                   const distance_t<P>& g,
+                                   T radius,
+                                   [[maybe_unused]] bool moved) {
+        const auto n = dimension(y);
+        for (std::size_t i{0}; i < n; ++i) {
+            w.step[i] = T{};
+            w.hessian_step[i] = T{};
+        }
+        assign(w.residual, lazy(g));
+        assign(w.direction, -lazy(g));
+
+        const auto g2 = norm(g);
+        const auto forcing = std::min(T{0.25F}, stdx::sqrt(g2)) * g2;
+
+        auto boundary = false;
+        auto r2 = g2;
+        for (std::size_t j{0}; j < n; ++j) {
+            w.hessian_direction = hessian_vector_product(y, w.direction, cost);
+            const auto curvature = dot(w.direction, w.hessian_direction);
+
+            auto alpha = T{};
+            boundary = not(curvature > T{});
+            if (not boundary) {
+                alpha = r2 / curvature;
+                boundary = norm(w.step) +
+                               alpha * (T{2} * dot(w.step, w.direction) +
+                                        alpha * norm(w.direction)) >=
+                           radius * radius;
+            }
+            if (boundary) {
+                alpha = detail::boundary_step(w.step, w.direction, radius);
+            }
+
+            assign(w.step, lazy(w.step) + alpha * lazy(w.direction));
+            assign(w.hessian_step,
+                   lazy(w.hessian_step) + alpha * lazy(w.hessian_direction));
+            if (boundary) {
+                break;
+            }
+
+            assign(w.residual,
+                   lazy(w.residual) + alpha * lazy(w.hessian_direction));
+            const auto next_r2 = norm(w.residual);
+            if (next_r2 < forcing) {
+                break;
+            }
+            assign(w.direction,
+                   (next_r2 / r2) * lazy(w.direction) - lazy(w.residual));
+            r2 = next_r2;
+        }
+
+        return detail::model_step<T>{
+            -(dot(g, w.step) + T{0.5F} * dot(w.step, w.hessian_step)),
+            boundary};
+    };
+
+    return detail::trust_region(
+        std::move(x), cost, w.trial, w.step, options, region, solve);
+}
+
+/// Minimizes `cost` from `x` with the Steihaug-CG trust-region method, on a
+/// workspace of its own
+template <Point P, Cost<P> F>
+constexpr auto
+trust_region_steihaug(P x,
+                      F cost,
+                      solver_options<scalar_t<P>> options = {},
+                      trust_region_options<scalar_t<P>> region = {})
+    -> solve_result<P>
+{
+    auto w = steihaug_workspace<P>{x};
+    return trust_region_steihaug(std::move(x), cost, w, options, region);
+}
+
+}  // namespace opt
@@ -4,8 +4,51 @@
 
 #include "boost/ut.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <span>
+
 // NOLINTBEGIN(readability-magic-numbers)
 
+namespace {
+
+/// Polynomial coupling neighbouring coordinates, evaluated on real and dual
+/// points only, one at a time or in batches
+///
+/// Counts the batches in `*batches`.
+struct batched_chain {
+    std::size_t* batches;
+
+    template <opt::Point P>
+        requires(opt::Dual<opt::scalar_t<P>> or
+                 std::floating_point<opt::scalar_t<P>>)
+    constexpr auto operator()(const P& x) const -> opt::scalar_t<P>
+    {
+        using T = opt::scalar_t<P>;
+
+        auto acc = T{};
+        for (std::size_t i{0}; i < opt::dimension(x); ++i) {
+            acc += (x[i] - T{1}) * (x[i] - T{1}) / T{2};
+        }
+        for (std::size_t i{0}; i + 1 < opt::dimension(x); ++i) {
+            acc += x[i] * x[i + 1] * x[i + 1];
+        }
+        return acc;
+    }
+
+    template <opt::Point P>
+    constexpr auto operator()(std::span<const P> xs,
+                              std::span<opt::scalar_t<P>> ys) const -> void
+    {
+        ++*batches;
+        std::ranges::transform(
+            xs, ys.begin(), [this](const P& x) { return (*this)(x); });
+    }
+};
+
+}  // namespace
+
 auto main() -> int
 {
     using namespace boost::ut;
@@ -24,6 +67,15 @@ auto main() -> int
         return (x[0] - T{3} * x[1]) * (x[0] - T{3} * x[1]) / T{2};
     };
 
+    constexpr auto cost_per_coordinate = []<opt::Point P>(const P& x)
+        requires(not opt::DualVec<opt::scalar_t<P>>)
+    {
+        using T = opt::scalar_t<P>;
+
+        return opt::exp((x[0] - T{3}) * (x[0] - T{3})) +
+               (x[1] + T{1}) * (x[1] + T{1});
+    };
+
     constexpr point p{2.0F, 0.0F};
 
     test("convopt gradient") = [&] {
@@ -31,6 +83,22 @@ auto main() -> int
                            vector{-2.0F * opt::exp(1.0F), 2.0F})>);
     };
 
+    test("convopt gradient single evaluation") = [&] {
+        static_assert(opt::VectorCost<decltype(cost), point<float, 2>>);
+        static_assert(
+            not opt::VectorCost<decltype(cost_per_coordinate), point<float, 2>>);
+
+        expect(constant<eq(opt::gradient(p, cost),
+                           opt::gradient(p, cost_per_coordinate))>);
+
+        constexpr point p3{1.0F, -2.0F, 0.5F};
+        constexpr auto cost3 = []<opt::Point P>(const P& x) {
+            return x[0] * x[1] * x[2] + x[1] * x[1] / x[0];
+        };
+        expect(constant<eq(opt::gradient(p3, cost3),
+                           vector{-1.0F - 4.0F, 0.5F - 4.0F, -2.0F})>);
+    };
+
     test("convopt hessian") = [&] {
         constexpr auto H{opt::hessian(p, cost_quadratic)};
 
@@ -38,6 +106,198 @@ auto main() -> int
         expect(constant<eq(H[1], vector{-3.0F, 9.0F})>);
     };
 
+    test("convopt hessian upper triangle") = [] {
+        constexpr auto cost3 = []<opt::Point P>(const P& x) {
+            return x[0] * x[1] * x[2] + x[1] * x[1] / x[0];
+        };
+        constexpr auto cost3_per_entry = []<opt::Point P>(const P& x)
+            requires(not opt::HyperDualVec<opt::scalar_t<P>>)
+        {
+            return x[0] * x[1] * x[2] + x[1] * x[1] / x[0];
+        };
+
+        static_assert(opt::HyperVectorCost<decltype(cost3), point<float, 3>>);
+        static_assert(not opt::HyperVectorCost<decltype(cost3_per_entry),
+                                               point<float, 3>>);
+
+        constexpr point p3{1.0F, -2.0F, 0.5F};
+        constexpr auto H{opt::hessian(p3, cost3)};
+
+        expect(constant<eq(H, opt::hessian(p3, cost3_per_entry))>);
+        expect(constant<opt::close_to(H[0], vector{8.0F, 4.5F, -2.0F}, 1e-5F)>);
+        expect(constant<opt::close_to(H[1], vector{4.5F, 2.0F, 1.0F}, 1e-5F)>);
+        expect(constant<opt::close_to(H[2], vector{-2.0F, 1.0F, 0.0F}, 1e-5F)>);
+        expect(eq(opt::hessian(p3, cost3), opt::hessian(p3, cost3_per_entry)));
+    };
+
+    test("convopt hessian vector product") = [] {
+        constexpr auto cost3 = []<opt::Point P>(const P& x) {
+            return x[0] * x[1] * x[2] + x[1] * x[1] / x[0];
+        };
+        constexpr auto cost3_lanes = []<opt::Point P>(const P& x)
+            requires(not opt::HyperDualVec<opt::scalar_t<P>>)
+        {
+            return x[0] * x[1] * x[2] + x[1] * x[1] / x[0];
+        };
+        constexpr auto cost3_dual = []<opt::Point P>(const P& x)
+            requires(opt::Dual<opt::scalar_t<P>> or
+                     std::floating_point<opt::scalar_t<P>>)
+        {
+            return x[0] * x[1] * x[2] + x[1] * x[1] / x[0];
+        };
+
+        static_assert(opt::LaneCost<decltype(cost3_lanes), point<float, 3>>);
+        static_assert(
+            not opt::LaneCost<decltype(cost3_dual), point<float, 3>>);
+
+        constexpr point p3{1.0F, -2.0F, 0.5F};
+        constexpr vector v{0.5F, -1.0F, 2.0F};
+        constexpr auto hv = opt::hessian(p3, cost3) * v;
+
+        expect(constant<opt::close_to(
+                   opt::hessian_vector_product(p3, v, cost3), hv, 1e-5F)>);
+        expect(constant<opt::close_to(
+                   opt::hessian_vector_product(p3, v, cost3_lanes),
+                   hv,
+                   1e-5F)>);
+        expect(constant<opt::close_to(
+                   opt::hessian_vector_product(p3, v, cost3_dual),
+                   hv,
+                   1e-5F)>);
+
+        // Points of dynamic size, more coordinates than lanes
+        auto x = opt::dyn_point<double>(11);
+        auto w = opt::dyn_vector<double>(11);
+        for (std::size_t i{0}; i < x.size(); ++i) {
+            x[i] = 0.1 * static_cast<double>(i) - 0.4;
+            w[i] = i % 2 == 0 ? 1.0 : -0.5;
+        }
+        const auto chained = []<opt::Point P>(const P& y) {
+            auto acc = opt::scalar_t<P>{};
+            for (std::size_t i{0}; i + 1 < opt::dimension(y); ++i) {
+                acc += opt::sin(y[i] * y[i + 1]) + y[i] * y[i] * y[i];
+            }
+            return acc;
+        };
+        const auto hw = opt::hessian_vector_product(x, w, chained);
+        expect(opt::close_to(
+            hw,
+            opt::hessian_vector_product(
+                x, w, [&chained]<opt::Point P>(const P& y)
+                    requires(opt::Dual<opt::scalar_t<P>> or
+                             std::floating_point<opt::scalar_t<P>>)
+                { return chained(y); }),
+            1e-12));
+
+        // Row 5 of the tridiagonal Hessian
+        const auto d = opt::detail::as_point_dual(x);
+        auto row = 0.0;
+        for (std::size_t j{4}; j < 7; ++j) {
+            auto dj = d;
+            dj[5].e1 = 1;
+            dj[j].e2 = 1;
+            row += chained(dj).e3 * w[j];
+        }
+        expect(le(opt::stdx::abs(hw[5] - row), 1e-12));
+    };
+
+    test("convopt lanes") = [] {
+        constexpr auto chained = []<opt::Point P>(const P& x) {
+            using T = opt::scalar_t<P>;
+
+            auto acc = T{};
+            for (std::size_t i{0}; i < opt::dimension(x); ++i) {
+                acc += (x[i] - T{1}) * (x[i] - T{1}) / T{2};
+            }
+            for (std::size_t i{0}; i + 1 < opt::dimension(x); ++i) {
+                acc += opt::sin(x[i] * x[i + 1]);
+            }
+            return acc;
+        };
+        constexpr auto chained_per_coordinate = [chained]<opt::Point P>(const P& x)
+            requires(opt::Dual<opt::scalar_t<P>> or
+                     std::same_as<opt::scalar_t<P>, float>)
+        {
+            return chained(x);
+        };
+        constexpr auto chained_lanes = [chained]<opt::Point P>(const P& x)
+            requires(not opt::HyperDualVec<opt::scalar_t<P>>)
+        {
+            return chained(x);
+        };
+
+        // 21 entries in the upper triangle, two partially filled blocks of
+        // lanes
+        using P6 = point<float, 6>;
+        static_assert(opt::LaneCost<decltype(chained_lanes), P6>);
+        static_assert(not opt::LaneCost<decltype(chained_per_coordinate), P6>);
+
+        constexpr auto p6 = P6{0.1F, -0.3F, 0.7F, 1.1F, -0.9F, 0.4F};
+        expect(constant<eq(opt::hessian(p6, chained_lanes),
+                           opt::hessian(p6, chained_per_coordinate))>);
+        expect(eq(opt::hessian(p6, chained_lanes),
+                  opt::hessian(p6, chained_per_coordinate)));
+
+        // 20 coordinates, more than the lanes of a single evaluation
+        const auto x = [] {
+            auto r = opt::dyn_point<float>(20);
+            for (std::size_t i{0}; i < r.size(); ++i) {
+                r[i] = 0.05F * static_cast<float>(i);
+            }
+            return r;
+        }();
+        expect(eq(opt::gradient(x, chained),
+                  opt::gradient(x, chained_per_coordinate)));
+    };
+
+    test("convopt batch cost") = [] {
+        auto batches = std::size_t{};
+        const auto chain = batched_chain{&batches};
+        const auto chain_per_point = [chain]<opt::Point P>(const P& x)
+            requires std::invocable<const batched_chain&, const P&>
+        { return chain(x); };
+
+        using P4 = point<double, 4>;
+        static_assert(opt::BatchCost<batched_chain, P4>);
+        static_assert(not opt::VectorCost<batched_chain, P4>);
+        static_assert(not opt::BatchCost<decltype(chain_per_point), P4>);
+
+        constexpr auto constant_hessian = [] {
+            auto n = std::size_t{};
+            constexpr auto x = P4{0.5, -1.0, 2.0, 0.25};
+            return opt::hessian(x, batched_chain{&n})[{1, 2}];
+        };
+        expect(constant<constant_hessian() == 4.0>);
+
+        // 150 coordinates, three batches with a serial scheduler
+        const auto x = [] {
+            auto r = opt::dyn_point<double>(150);
+            for (std::size_t i{0}; i < r.size(); ++i) {
+                r[i] = 0.01 * static_cast<double>(i) - 0.5;
+            }
+            return r;
+        }();
+        const auto g = opt::gradient(x, chain, opt::serial{});
+        expect(eq(batches, std::size_t{3}));
+        expect(eq(g, opt::gradient(x, chain_per_point)));
+
+        // 10 entries in the upper triangle, a single batch
+        batches = 0;
+        const auto x4 = P4{0.5, -1.0, 2.0, 0.25};
+        expect(eq(opt::hessian(x4, chain, opt::serial{}),
+                  opt::hessian(x4, chain_per_point)));
+        expect(eq(batches, std::size_t{1}));
+
+        // The value at each trial step comes with its gradient
+        const auto batched =
+            opt::line_search(x, -g, chain, chain(x), g, opt::more_thuente{});
+        const auto plain = opt::line_search(
+            x, -g, chain_per_point, chain(x), g, opt::more_thuente{});
+        expect(eq(batched.x, plain.x));
+        expect(eq(batched.gradient_evaluations, plain.gradient_evaluations));
+        expect(lt(batched.cost_evaluations, plain.cost_evaluations));
+    };
+
     const auto q{p};
     test("convopt gradient") = [&] {
         expect(
@@ -46,7 +306,68 @@ auto main() -> int
 
     test("convopt optimize") = [&] {
         expect(constant<opt::close_to(
-                   opt::optimize(p, cost), point{3.0F, -1.0F}, 1e-2F)>);
+                   opt::optimize(p, cost).x, point{3.0F, -1.0F}, 1e-2F)>);
+    };
+
+    test("convopt optimize options") = [&] {
+        constexpr auto r = opt::optimize(p, cost);
+        expect(constant<r.converged()>);
+        expect(constant<r.reason == opt::stop_reason::gradient_tolerance>);
+        expect(constant<(opt::norm(r.gradient) < 1e-8F)>);
+
+        const auto loose = opt::optimize(p, cost, {.gradient_tolerance = 1.0F});
+        expect(loose.reason == opt::stop_reason::gradient_tolerance);
+        expect(lt(loose.iterations, r.iterations));
+
+        const auto few = opt::optimize(p, cost, {.max_iterations = 2});
+        expect(few.reason == opt::stop_reason::max_iterations);
+        expect(eq(few.iterations, std::size_t{2}));
+        expect(not few.converged());
+
+        const auto value = opt::optimize(
+            p, cost, {.gradient_tolerance = 0.0F, .value_tolerance = 1e-3F});
+        expect(value.reason == opt::stop_reason::value_tolerance);
+        expect(value.converged());
+
+        const auto step = opt::optimize(
+            p, cost, {.gradient_tolerance = 0.0F, .step_tolerance = 1e-2F});
+        expect(step.reason == opt::stop_reason::step_tolerance);
+
+        const auto evaluations = opt::optimize(p, cost, {.max_evaluations = 5});
+        expect(evaluations.reason == opt::stop_reason::max_evaluations);
+        expect(ge(evaluations.cost_evaluations +
+                      evaluations.gradient_evaluations,
+                  std::size_t{5}));
+
+        const auto timed =
+            opt::optimize(p, cost, {.time_budget = std::chrono::nanoseconds{}});
+        expect(timed.reason == opt::stop_reason::time_budget);
+        expect(eq(timed.iterations, std::size_t{0}));
+        expect(eq(timed.x, p));
+    };
+
+    test("convopt dynamic dimension") = [&] {
+        using opt::dyn_point;
+        using opt::dyn_vector;
+
+        constexpr auto ok = [cost] {
+            const auto x = dyn_point{{2.0F, 0.0F}};
+
+            return opt::gradient(x, cost) ==
+                       dyn_vector{{-2.0F * opt::exp(1.0F), 2.0F}} and
+                   opt::close_to(opt::optimize(x, cost).x,
+                                 dyn_point{{3.0F, -1.0F}},
+                                 1e-2F);
+        };
+        expect(constant<ok()>);
+
+        const auto x = dyn_point{{2.0F, 0.0F}};
+        const auto step =
+            opt::line_search(x, -opt::gradient(x, cost), cost).x;
+        const auto expected =
+            opt::line_search(p, -opt::gradient(p, cost), cost).x;
+
+        expect(eq(step, dyn_point{{expected[0], expected[1]}}));
     };
 }
 
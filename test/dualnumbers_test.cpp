@@ -50,6 +50,76 @@ auto main() -> int
         expect(constant<eq(x, ratio * y)>);
     };
 
+    test("dualnumbers vector sum and product") = [] {
+        using dv = opt::dual_vec<float, 2>;
+        constexpr dv x{2.0F, {1.0F, 0.0F}};
+        constexpr dv y{3.0F, {0.0F, 1.0F}};
+
+        expect(constant<eq(x + y, dv{5.0F, {1.0F, 1.0F}})>);
+        expect(constant<eq(x - y, dv{-1.0F, {1.0F, -1.0F}})>);
+        expect(constant<eq(-x, dv{-2.0F, {-1.0F, -0.0F}})>);
+        expect(constant<eq(x * y, dv{6.0F, {3.0F, 2.0F}})>);
+    };
+
+    test("dualnumbers vector division") = [] {
+        using dv = opt::dual_vec<float, 3>;
+        constexpr dv x{1.0F, {0.0F, 0.0F, 0.0F}};
+        constexpr dv y{1.0F, {1.0F, 2.0F, 3.0F}};
+        constexpr dv ratio{x / y};
+
+        expect(constant<eq(x, ratio * y)>);
+    };
+
+    test("dualnumbers vector agrees with scalar dual") = [] {
+        constexpr dual x{1.5F, 1.0F, 0.0F, 0.0F};
+        constexpr dual y{-0.5F, 0.0F, 0.0F, 0.0F};
+
+        using dv = opt::dual_vec<float, 1>;
+        constexpr dv xv{1.5F, {1.0F}};
+        constexpr dv yv{-0.5F, {0.0F}};
+
+        constexpr auto r = (x * x + y) / (x - y);
+        constexpr auto rv = (xv * xv + yv) / (xv - yv);
+
+        expect(constant<eq(r.real, rv.real)>);
+        expect(constant<eq(r.e1, rv.eps[0])>);
+    };
+
+    test("dualnumbers hyper vector agrees with scalar dual") = [] {
+        constexpr dual x{1.5F, 1.0F, 1.0F, 0.0F};
+        constexpr dual y{-0.5F, 0.0F, 0.0F, 0.0F};
+
+        using hv = opt::hyper_dual_vec<float, 2>;
+        constexpr hv xv{1.5F, 1.0F, {1.0F, 0.0F}, {0.0F, 0.0F}};
+        constexpr hv yv{-0.5F, 0.0F, {0.0F, 1.0F}, {0.0F, 0.0F}};
+
+        constexpr auto r = (x * x + y) / (x - y);
+        constexpr auto rv = (xv * xv + yv) / (xv - yv);
+
+        expect(constant<eq(r.real, rv.real)>);
+        expect(constant<eq(r.e1, rv.e1)>);
+        expect(constant<eq(r.e2, rv.e2[0])>);
+        expect(constant<eq(r.e3, rv.e3[0])>);
+        expect(constant<eq(-rv, hv{} - rv)>);
+    };
+
+    test("dualnumbers lanes agree with scalar dual") = [] {
+        constexpr dual x0{1.5F, 1.0F, 1.0F, 0.0F};
+        constexpr dual y0{-0.5F, 0.0F, 0.0F, 0.0F};
+        constexpr dual x1{1.5F, 0.0F, 1.0F, 0.0F};
+        constexpr dual y1{-0.5F, 1.0F, 0.0F, 0.0F};
+
+        using dl = opt::dual_lanes<float, 2>;
+        constexpr dl x{1.5F, {1.0F, 0.0F}, {1.0F, 1.0F}, {0.0F, 0.0F}};
+        constexpr dl y{-0.5F, {0.0F, 1.0F}, {0.0F, 0.0F}, {0.0F, 0.0F}};
+
+        constexpr auto r = (x * x + y) / (x - y);
+
+        expect(constant<eq(r.lane(0), (x0 * x0 + y0) / (x0 - y0))>);
+        expect(constant<eq(r.lane(1), (x1 * x1 + y1) / (x1 - y1))>);
+        expect(constant<eq(-r, dl{} - r)>);
+    };
+
     // Add tests for / and affine and nonlinear functions
 }
 
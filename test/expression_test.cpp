@@ -0,0 +1,102 @@
+#include "src/expression.hpp"
+#include "src/spaces.hpp"
+
+#include "boost/ut.hpp"
+
+#include <utility>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+namespace {
+
+template <class L, class R>
+concept summable = requires(L&& l, R&& r) {
+    std::forward<L>(l) + std::forward<R>(r);
+};
+
+template <class L, class R>
+concept subtractable = requires(L&& l, R&& r) {
+    std::forward<L>(l) - std::forward<R>(r);
+};
+
+}  // namespace
+
+auto main() -> int
+{
+    using namespace boost::ut;
+
+    using opt::eval;
+    using opt::lazy;
+    using opt::point;
+    using opt::vector;
+
+    test("expression vector arithmetic") = [] {
+        constexpr vector v1{0.1F, -2.5F, 3.3F};
+        constexpr vector v2{1.7F, 0.3F, -0.9F};
+        constexpr float s{0.7F};
+
+        expect(constant<eq(eval(lazy(v1) + lazy(v2)), v1 + v2)>);
+        expect(constant<eq(eval(lazy(v1) - v2), v1 - v2)>);
+        expect(constant<eq(eval(-lazy(v1)), -v1)>);
+        expect(constant<eq(eval(s * lazy(v1)), s * v1)>);
+        expect(constant<eq(eval(lazy(v1) * s), v1 * s)>);
+        expect(constant<eq(eval(s * lazy(v1) - lazy(v2) * s + lazy(v1)),
+                           s * v1 - v2 * s + v1)>);
+    };
+
+    test("expression operands outlive it") = [] {
+        using P = vector<float, 3>;
+        using E = decltype(lazy(std::declval<const P&>()));
+
+        static_assert(summable<E, const P&>);
+        static_assert(summable<const P&, E>);
+        static_assert(subtractable<E, const P&>);
+        static_assert(subtractable<const P&, E>);
+
+        static_assert(not summable<E, P>);
+        static_assert(not summable<P, E>);
+        static_assert(not subtractable<E, P>);
+        static_assert(not subtractable<P, E>);
+    };
+
+    test("expression point arithmetic") = [] {
+        constexpr point p{0.1F, -2.5F, 3.3F};
+        constexpr point q{1.7F, 0.3F, -0.9F};
+        constexpr vector d{-0.4F, 1.1F, 0.01F};
+        constexpr float lambda{0.001F};
+
+        expect(constant<eq(eval(lazy(p) + lambda * lazy(d)), p + lambda * d)>);
+        expect(constant<eq(eval(lazy(p) - lazy(q)), p - q)>);
+        expect(constant<eq(eval(lazy(d) + lazy(p)), d + p)>);
+        expect(constant<eq(eval(lazy(p) - (lazy(q) - lazy(p)) * 0.5F),
+                           p - (q - p) * 0.5F)>);
+    };
+
+    test("expression assign in place") = [] {
+        constexpr auto ok = [] {
+            auto p = point{0.1F, -2.5F, 3.3F};
+            const auto ones = point{1.0F, 1.0F, 1.0F};
+            const auto expected = p + 2.0F * (p - ones);
+
+            opt::assign(p, lazy(p) + 2.0F * (lazy(p) - ones));
+            return p == expected;
+        };
+        expect(constant<ok()>);
+    };
+
+    test("expression dynamic dimension") = [] {
+        using opt::dyn_point;
+        using opt::dyn_vector;
+
+        constexpr auto ok = [] {
+            const auto p = dyn_point{{0.1, -2.5, 3.3}};
+            const auto d = dyn_vector{{-0.4, 1.1, 0.01}};
+
+            return eval(lazy(p) + 0.3 * lazy(d)) == p + 0.3 * d and
+                   eval(lazy(p) - lazy(p)) == p - p;
+        };
+        expect(constant<ok()>);
+    };
+}
+
+// NOLINTEND(readability-magic-numbers)
@@ -0,0 +1,140 @@
+#include "src/convopt.hpp"
+#include "src/lbfgs.hpp"
+#include "src/math.hpp"
+#include "src/spaces.hpp"
+
+#include "boost/ut.hpp"
+
+#include <cstddef>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+auto main() -> int
+{
+    using namespace boost::ut;
+    using opt::point;
+    using opt::vector;
+
+    constexpr auto cost = []<opt::Point P>(const P& x) {
+        using T = opt::scalar_t<P>;
+
+        return opt::exp((x[0] - T{3}) * (x[0] - T{3})) +
+               (x[1] + T{1}) * (x[1] + T{1});
+    };
+
+    constexpr auto rosenbrock = []<opt::Point P>(const P& x) {
+        using T = opt::scalar_t<P>;
+
+        const auto a = T{1} - x[0];
+        const auto b = x[1] - x[0] * x[0];
+        return a * a + T{100} * b * b;
+    };
+
+    // Diagonal quadratic with condition number 1000, minimum at 1, 2, ...
+    constexpr auto ill_conditioned = []<opt::Point P>(const P& x) {
+        using T = opt::scalar_t<P>;
+
+        const auto n = opt::dimension(x);
+        auto acc = T{};
+        for (std::size_t i{0}; i < n; ++i) {
+            const auto w = T{1} + T{999} * T(static_cast<double>(i)) /
+                                      T(static_cast<double>(n - 1));
+            const auto d = x[i] - T(static_cast<double>(i + 1));
+            acc += w * d * d;
+        }
+        return acc;
+    };
+
+    test("lbfgs test cost") = [&] {
+        constexpr point p{2.0F, 0.0F};
+
+        expect(constant<opt::close_to(
+                   opt::lbfgs(p, cost).x, point{3.0F, -1.0F}, 1e-2F)>);
+        expect(constant<opt::close_to(
+                   opt::lbfgs<1>(p, cost).x, point{3.0F, -1.0F}, 1e-2F)>);
+        expect(constant<opt::close_to(
+                   opt::lbfgs<3, opt::strong_wolfe>(p, cost).x,
+                   point{3.0F, -1.0F},
+                   1e-2F)>);
+    };
+
+    test("lbfgs cost evaluations") = [&] {
+        auto n = std::size_t{};
+        const auto counted = [&n, &cost]<opt::Point P>(const P& x) {
+            ++n;
+            return cost(x);
+        };
+
+        // Counts evaluations on dual numbers for the gradient too
+        const auto r =
+            opt::lbfgs(point{2.0, 0.0}, counted, {.gradient_tolerance = 1e-8});
+        expect(r.reason == opt::stop_reason::gradient_tolerance);
+        expect(opt::close_to(r.x, point{3.0, -1.0}, 1e-6));
+        expect(lt(n, std::size_t{30}));
+    };
+
+    test("lbfgs rosenbrock") = [&] {
+        constexpr point p{-1.2, 1.0};
+
+        constexpr auto r =
+            opt::lbfgs(p, rosenbrock, {.gradient_tolerance = 1e-8});
+        expect(constant<r.converged()>);
+        expect(constant<opt::close_to(r.x, point{1.0, 1.0}, 1e-6)>);
+
+        const auto few = opt::lbfgs(p, rosenbrock, {.max_iterations = 5});
+        expect(few.reason == opt::stop_reason::max_iterations);
+        expect(eq(few.iterations, std::size_t{5}));
+
+        // Far from the minimum after the steps of steepest descent
+        expect(not opt::close_to(
+            opt::optimize(p, rosenbrock, {.max_iterations = 10}).x,
+            point{1.0, 1.0},
+            1e-1));
+    };
+
+    test("lbfgs ill conditioned dynamic dimension") = [&] {
+        const auto x = opt::lbfgs(opt::dyn_point<double>(50),
+                                  ill_conditioned,
+                                  {.gradient_tolerance = 1e-8})
+                           .x;
+
+        auto expected = opt::dyn_point<double>(50);
+        for (std::size_t i{0}; i < 50; ++i) {
+            expected[i] = static_cast<double>(i + 1);
+        }
+        expect(opt::close_to(x, expected, 1e-6));
+    };
+
+    test("lbfgs history ring buffer") = [] {
+        using V = vector<double, 2>;
+
+        auto h = opt::impl::lbfgs_history<V, 2>{V{}};
+        auto d = V{};
+
+        // Without pairs the direction is the steepest descent
+        h.direction(V{1.0, -2.0}, d);
+        expect(eq(d, V{-1.0, 2.0}));
+
+        // Negative curvature is skipped
+        h.push(point{0.0, 0.0}, point{1.0, 0.0}, V{}, V{-1.0, 0.0});
+        expect(eq(h.size(), std::size_t{0}));
+
+        // Keeps the last two pairs of a quadratic with Hessian diag(2, 8)
+        h.push(point{0.0, 0.0}, point{1.0, 0.0}, V{}, V{2.0, 0.0});
+        h.push(point{1.0, 0.0}, point{1.0, 1.0}, V{2.0, 0.0}, V{2.0, 8.0});
+        h.push(point{1.0, 1.0}, point{2.0, 1.0}, V{2.0, 8.0}, V{4.0, 8.0});
+        expect(eq(h.size(), std::size_t{2}));
+
+        h.direction(V{2.0, 8.0}, d);
+        expect(opt::close_to(d, V{-1.0, -1.0}, 1e-12));
+
+        // A full buffer keeps both pairs when a new one is skipped
+        h.push(point{2.0, 1.0}, point{3.0, 1.0}, V{4.0, 8.0}, V{3.0, 8.0});
+        expect(eq(h.size(), std::size_t{2}));
+
+        h.direction(V{2.0, 8.0}, d);
+        expect(opt::close_to(d, V{-1.0, -1.0}, 1e-12));
+    };
+}
+
+// NOLINTEND(readability-magic-numbers)
@@ -0,0 +1,187 @@
+#include "src/convopt.hpp"
+#include "src/least_squares.hpp"
+#include "src/math.hpp"
+#include "src/solver_options.hpp"
+#include "src/spaces.hpp"
+
+#include "boost/ut.hpp"
+
+#include <array>
+#include <cstddef>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+namespace {
+
+constexpr auto times = std::array{0.0, 0.5, 1.0, 1.5, 2.0, 3.0, 4.0, 6.0};
+
+}  // namespace
+
+auto main() -> int
+{
+    using namespace boost::ut;
+    using opt::point;
+    using opt::vector;
+
+    // Rosenbrock as the sum of the squares of two residuals
+    constexpr auto rosenbrock = []<opt::Point P>(const P& x) {
+        using T = opt::scalar_t<P>;
+
+        return vector{T{10} * (x[1] - x[0] * x[0]), T{1} - x[0]};
+    };
+
+    // Exponential decay `a exp(b t)` through samples of `2 exp(-t / 2)`
+    constexpr auto decay = []<opt::Point P>(const P& x) {
+        using T = opt::scalar_t<P>;
+
+        auto r = vector<T, times.size()>{};
+        for (std::size_t i{0}; i < times.size(); ++i) {
+            const auto t = T{times[i]};
+            const auto sample = 2.0 * opt::exp(-0.5 * times[i]);
+            r[i] = x[0] * opt::exp(x[1] * t) - T{sample};
+        }
+        return r;
+    };
+
+    constexpr auto tight = opt::solver_options<double>{
+        .gradient_tolerance = 1e-10, .max_iterations = 200};
+
+    test("least squares jacobian") = [&] {
+        constexpr auto cubic = []<opt::Point P>(const P& x) {
+            return vector{x[0] * x[1], x[1] * x[1] * x[2], x[0] / x[2]};
+        };
+        constexpr auto cubic_per_column = []<opt::Point P>(const P& x)
+            requires(not opt::DualVec<opt::scalar_t<P>>)
+        {
+            return vector{x[0] * x[1], x[1] * x[1] * x[2], x[0] / x[2]};
+        };
+
+        static_assert(opt::VectorResiduals<decltype(cubic), point<double, 3>>);
+        static_assert(
+            not opt::VectorResiduals<decltype(cubic_per_column),
+                                     point<double, 3>>);
+
+        constexpr auto p = point{2.0, -1.0, 0.5};
+        constexpr auto jr = opt::jacobian(p, cubic);
+        constexpr auto j = jr.jacobian;
+        expect(constant<eq(j[0], vector{-1.0, 0.0, 2.0})>);
+        expect(constant<eq(j[1], vector{2.0, -1.0, 0.0})>);
+        expect(constant<eq(j[2], vector{0.0, 1.0, -8.0})>);
+        expect(constant<eq(jr.residuals, cubic(p))>);
+        expect(constant<eq(jr.evaluations, std::size_t{1})>);
+
+        // One evaluation per column
+        constexpr auto per_column = opt::jacobian(p, cubic_per_column);
+        expect(constant<eq(per_column.jacobian, j)>);
+        expect(constant<eq(per_column.residuals, cubic(p))>);
+        expect(constant<eq(per_column.evaluations, std::size_t{3})>);
+        const auto parallel =
+            opt::jacobian(p, cubic_per_column, opt::parallel{1});
+        expect(eq(parallel.jacobian, j));
+        expect(eq(parallel.residuals, cubic(p)));
+
+        // Rows of residuals of another size than the point
+        const auto q = point{0.3, -0.2};
+        const auto jd = opt::jacobian(q, decay).jacobian;
+        expect(eq(jd.rows, times.size()));
+        expect(eq(jd.cols, std::size_t{2}));
+        for (std::size_t i{0}; i < times.size(); ++i) {
+            const auto expected = q[0] * times[i] * opt::exp(q[1] * times[i]);
+            expect(le(opt::stdx::abs(jd[{i, 1}] - expected), 1e-15));
+        }
+    };
+
+    test("least squares sum of squares") = [&] {
+        constexpr auto cost = opt::sum_of_squares{rosenbrock};
+        static_assert(opt::Cost<decltype(cost), point<double, 2>>);
+
+        expect(constant<eq(cost(point{2.0, 3.0}), (10.0 * 10.0 + 1.0) / 2.0)>);
+
+        constexpr auto p = point{-1.2, 1.0};
+
+        // The gradient is Jᵀ r
+        const auto j = opt::jacobian(p, rosenbrock).jacobian;
+        const auto r = rosenbrock(p);
+        const auto g = opt::gradient(p, cost);
+        expect(le(opt::stdx::abs(g[0] - opt::dot(j[0], r)), 1e-12));
+        expect(le(opt::stdx::abs(g[1] - opt::dot(j[1], r)), 1e-12));
+    };
+
+    test("least squares levenberg marquardt") = [&] {
+        constexpr auto r =
+            opt::levenberg_marquardt(point{-1.2, 1.0}, rosenbrock, tight);
+        expect(constant<r.reason == opt::stop_reason::gradient_tolerance>);
+        expect(constant<opt::close_to(r.x, point{1.0, 1.0}, 1e-10)>);
+        expect(constant<(r.iterations < 30)>);
+
+        const auto fit =
+            opt::levenberg_marquardt(point{1.0, 0.0}, decay, tight);
+        expect(fit.converged());
+        expect(opt::close_to(fit.x, point{2.0, -0.5}, 1e-10));
+        expect(lt(fit.iterations, std::size_t{20}));
+        // The Jacobian is only evaluated after successful steps
+        expect(le(fit.gradient_evaluations, fit.iterations + 1));
+        expect(le(fit.value, 1e-20));
+
+        // Each Jacobian of residuals without vector duals takes an
+        // evaluation per column
+        const auto rosenbrock_per_column =
+            [rosenbrock]<opt::Point P>(const P& x)
+                requires(not opt::DualVec<opt::scalar_t<P>>)
+            { return rosenbrock(x); };
+        const auto vec =
+            opt::levenberg_marquardt(point{-1.2, 1.0}, rosenbrock, tight);
+        const auto per_column = opt::levenberg_marquardt(
+            point{-1.2, 1.0}, rosenbrock_per_column, tight);
+        expect(eq(per_column.iterations, vec.iterations));
+        expect(eq(per_column.cost_evaluations, vec.cost_evaluations));
+        expect(eq(per_column.gradient_evaluations,
+                  2 * vec.gradient_evaluations));
+
+        // Steepest descent is far from the minimum in as many iterations
+        const auto descent = opt::optimize(
+            point{-1.2, 1.0}, opt::sum_of_squares{rosenbrock}, tight);
+        expect(not descent.converged());
+        expect(gt(opt::norm(descent.x - point{1.0, 1.0}), 1e-6));
+    };
+
+    test("least squares gauss newton") = [&] {
+        constexpr auto fit = opt::gauss_newton(point{1.0, 0.0}, decay, tight);
+        expect(constant<fit.converged()>);
+        expect(constant<opt::close_to(fit.x, point{2.0, -0.5}, 1e-10)>);
+        expect(constant<(fit.iterations < 20)>);
+
+        const auto r = opt::gauss_newton(point{-1.2, 1.0}, rosenbrock, tight);
+        expect(r.converged());
+        expect(opt::close_to(r.x, point{1.0, 1.0}, 1e-10));
+
+        // Residuals not vanishing at the minimum, where both methods meet
+        constexpr auto inconsistent = []<opt::Point P>(const P& x) {
+            using T = opt::scalar_t<P>;
+
+            return vector{x[0] - T{1}, x[1] - T{2}, x[0] + x[1] - T{4},
+                          x[0] * x[1] - T{1}};
+        };
+        const auto loose = opt::solver_options<double>{
+            .gradient_tolerance = 1e-8, .max_iterations = 200};
+        const auto gn = opt::gauss_newton(point{0.0, 0.0}, inconsistent, loose);
+        const auto lm =
+            opt::levenberg_marquardt(point{0.0, 0.0}, inconsistent, loose);
+        expect(gn.converged());
+        expect(lm.converged());
+        expect(gt(lm.value, 0.1));
+        expect(opt::close_to(gn.x, lm.x, 1e-6));
+    };
+
+    test("least squares undefined jacobian") = [] {
+        // The residuals and their derivatives are NaN at the start
+        const auto p = point{-1.0, 1.0};
+        const auto r = opt::gauss_newton(p, []<opt::Point P>(const P& x) {
+            return vector{opt::sqrt(x[0]), x[1]};
+        });
+        expect(r.reason == opt::stop_reason::factorization_failed);
+        expect(eq(r.x, p));
+    };
+}
+
+// NOLINTEND(readability-magic-numbers)
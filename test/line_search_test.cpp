@@ -0,0 +1,163 @@
+#include "src/convopt.hpp"
+#include "src/line_search.hpp"
+#include "src/math.hpp"
+#include "src/spaces.hpp"
+
+#include "boost/ut.hpp"
+
+#include <cstddef>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+namespace {
+
+constexpr auto satisfies_armijo =
+    [](const auto& r, double value, double slope) {
+        return r.alpha > 0.0 and r.value <= value + 1e-4 * r.alpha * slope;
+    };
+constexpr auto satisfies_strong_wolfe = [](const auto& r,
+                                           const auto& direction,
+                                           double value,
+                                           double slope) {
+    const auto s = opt::dot(r.gradient, direction);
+    return r.alpha > 0.0 and
+           r.value <= value + 1e-4 * r.alpha * slope and
+           (s < 0.0 ? -s : s) <= 0.9 * -slope;
+};
+
+}  // namespace
+
+auto main() -> int
+{
+    using namespace boost::ut;
+    using opt::point;
+    using opt::vector;
+
+    // Minimum at (100, -1), far away from the origin compared to the scale of
+    // the old fixed step
+    constexpr auto far = []<opt::Point P>(const P& x) {
+        using T = opt::scalar_t<P>;
+        return (x[0] - T{100}) * (x[0] - T{100}) +
+               T{4} * (x[1] + T{1}) * (x[1] + T{1});
+    };
+
+    constexpr auto cost = []<opt::Point P>(const P& x) {
+        using T = opt::scalar_t<P>;
+
+        return opt::exp((x[0] - T{3}) * (x[0] - T{3})) +
+               (x[1] + T{1}) * (x[1] + T{1});
+    };
+
+    test("line search backtracking armijo") = [&] {
+        constexpr auto r = [&] {
+            constexpr point x{0.0, 0.0};
+            const auto g = opt::gradient(x, far);
+            return opt::line_search(x, -g, far, opt::backtracking_armijo{});
+        }();
+
+        expect(constant<satisfies_armijo(r, far(point{0.0, 0.0}), -40016.0)>);
+        // At the origin and at the accepted step only
+        expect(constant<r.gradient_evaluations == 2>);
+        expect(constant<eq(r.gradient, opt::gradient(r.x, far))>);
+    };
+
+    test("line search strong wolfe") = [&] {
+        constexpr point x{0.0, 0.0};
+        constexpr auto d = -opt::gradient(x, far);
+        constexpr auto r = opt::line_search(x, d, far, opt::strong_wolfe{});
+
+        expect(constant<satisfies_strong_wolfe(
+                   r, d, far(point{0.0, 0.0}), -40016.0)>);
+        expect(constant<eq(r.value, far(r.x))>);
+        expect(constant<eq(r.gradient, opt::gradient(r.x, far))>);
+    };
+
+    test("line search more thuente") = [&] {
+        constexpr point x{0.0, 0.0};
+        constexpr auto d = -opt::gradient(x, far);
+        constexpr auto r = opt::line_search(x, d, far, opt::more_thuente{});
+
+        expect(constant<satisfies_strong_wolfe(
+                   r, d, far(point{0.0, 0.0}), -40016.0)>);
+        expect(constant<eq(r.value, far(r.x))>);
+        expect(constant<eq(r.gradient, opt::gradient(r.x, far))>);
+
+        // Fixed steps of 0.001 needed hundreds of evaluations
+        expect(constant<r.cost_evaluations < 10>);
+    };
+
+    test("line search tight curvature condition") = [&] {
+        constexpr point x{2.0, 0.0};
+        constexpr auto d = -opt::gradient(x, cost);
+        constexpr auto value = cost(x);
+        constexpr auto slope = opt::dot(opt::gradient(x, cost), d);
+
+        constexpr auto r = opt::line_search(
+            x, d, cost, opt::more_thuente{.gtol = 0.1F});
+        const auto s = opt::dot(r.gradient, d);
+
+        expect(constant<satisfies_armijo(r, value, slope)>);
+        expect(le(s < 0.0 ? -s : s, 0.1 * -slope));
+
+        constexpr auto w =
+            opt::line_search(x, d, cost, opt::strong_wolfe{.c2 = 0.1F});
+        const auto sw = opt::dot(w.gradient, d);
+
+        expect(constant<satisfies_armijo(w, value, slope)>);
+        expect(le(sw < 0.0 ? -sw : sw, 0.1 * -slope));
+    };
+
+    test("line search ascent direction") = [&] {
+        constexpr point x{0.0, 0.0};
+        constexpr auto g = opt::gradient(x, far);
+        constexpr auto r = opt::line_search(x, g, far);
+
+        expect(constant<r.alpha == 0.0>);
+        expect(constant<r.x == x>);
+        expect(constant<eq(r.gradient, g)>);
+    };
+
+    test("line search caches the last trial") = [&] {
+        constexpr point x{0.0, 0.0};
+        constexpr auto g = opt::gradient(x, far);
+        const auto d = -g;
+
+        auto phi = opt::line_function{x, d, far, far(x), g};
+
+        expect(eq(phi.value(0.0), far(x)));
+        expect(eq(phi.sample(0.0).slope, opt::dot(g, d)));
+        expect(eq(phi.cost_evaluations(), std::size_t{0}));
+        expect(eq(phi.gradient_evaluations(), std::size_t{0}));
+
+        const auto v = phi.value(0.25);
+        const auto s = phi.sample(0.25);
+        expect(eq(s.value, v));
+        expect(eq(phi.cost_evaluations(), std::size_t{1}));
+        expect(eq(phi.gradient_evaluations(), std::size_t{1}));
+
+        static_cast<void>(phi.sample(0.5));
+        static_cast<void>(phi.gradient(0.5));
+        expect(eq(phi.cost_evaluations(), std::size_t{2}));
+        expect(eq(phi.gradient_evaluations(), std::size_t{2}));
+    };
+
+    test("line search optimize policies") = [&] {
+        constexpr point x{2.0F, 0.0F};
+        constexpr point expected{3.0F, -1.0F};
+
+        expect(constant<opt::close_to(
+                   opt::optimize<opt::backtracking_armijo>(x, cost).x,
+                   expected,
+                   1e-2F)>);
+        expect(constant<opt::close_to(
+                   opt::optimize<opt::strong_wolfe>(x, cost).x,
+                   expected,
+                   1e-2F)>);
+        expect(constant<opt::close_to(
+                   opt::optimize<opt::more_thuente>(x, cost).x,
+                   expected,
+                   1e-2F)>);
+    };
+}
+
+// NOLINTEND(readability-magic-numbers)
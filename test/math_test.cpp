@@ -3,7 +3,11 @@
 
 #include "boost/ut.hpp"
 
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
 
 // NOLINTBEGIN(readability-magic-numbers)
 
@@ -46,6 +50,39 @@ auto main() -> int
                    tol)>);
     };
 
+    test("dualnumbers math vector exp") = [&x, tol] {
+        constexpr opt::dual_vec<float, 2> y{1.0F, {2.0F, 3.0F}};
+        constexpr auto e = opt::exp(y);
+        constexpr auto ex = opt::exp(x);
+
+        expect(constant<eq(e.real, ex.real)>);
+        expect(constant<eq(e.eps[0], ex.e1)>);
+        expect(constant<eq(e.eps[1], ex.e2)>);
+        expect(le(e.eps[0], 2.0F * std::exp(1.0F) + tol) and
+               ge(e.eps[0], 2.0F * std::exp(1.0F) - tol));
+    };
+
+    test("dualnumbers math hyper vector sin") = [&x] {
+        constexpr opt::hyper_dual_vec<float, 2> y{
+            1.0F, 2.0F, {3.0F, 1.0F}, {0.0F, 0.0F}};
+        constexpr auto s = opt::sin(y);
+        constexpr auto sx = opt::sin(x);
+
+        expect(constant<eq(s.real, sx.real)>);
+        expect(constant<eq(s.e1, sx.e1)>);
+        expect(constant<eq(s.e2[0], sx.e2)>);
+        expect(constant<eq(s.e3[0], sx.e3)>);
+    };
+
+    test("dualnumbers math lanes sin") = [&x] {
+        constexpr opt::dual_lanes<float, 2> y{
+            1.0F, {2.0F, 0.0F}, {3.0F, 1.0F}, {0.0F, 0.5F}};
+        constexpr auto s = opt::sin(y);
+
+        expect(constant<eq(s.lane(0), opt::sin(x))>);
+        expect(constant<eq(s.lane(1), opt::sin(y.lane(1)))>);
+    };
+
     test("dualnumbers math cos") = [&x, tol] {
         expect(eq(std::cos(1.0F), opt::cos(1.0F)));
 
@@ -84,6 +121,193 @@ auto main() -> int
                  2.0F * 3.0F * (2.0F * std::cos(1.0F) - 4.0F * std::sin(1.0F))},
             tol));
     };
+
+    test("math elementary accuracy") = [] {
+        // Relative error against <cmath>, in units of the machine epsilon
+        const auto error = [](auto r, auto expected) {
+            using T = decltype(r);
+            return std::abs(r - expected) /
+                   (std::abs(expected) * std::numeric_limits<T>::epsilon() +
+                    std::numeric_limits<T>::denorm_min());
+        };
+
+        for (std::size_t i{1}; i < 400; ++i) {
+            const auto x = -20.0 + 0.1 * static_cast<double>(i);
+            const auto xf = static_cast<float>(x);
+            const auto pos = 0.05 * static_cast<double>(i);
+            const auto posf = static_cast<float>(pos);
+
+            expect(le(error(opt::exp(xf), std::exp(xf)), 1.0F));
+            expect(le(error(opt::sin(xf), std::sin(xf)), 1.0F));
+            expect(le(error(opt::cos(xf), std::cos(xf)), 1.0F));
+            expect(le(error(opt::tan(xf), std::tan(xf)), 1.0F));
+            expect(le(error(opt::tanh(xf), std::tanh(xf)), 2.0F));
+            expect(le(error(opt::log(posf), std::log(posf)), 1.0F));
+            expect(le(error(opt::log1p(posf), std::log1p(posf)), 1.0F));
+            expect(le(error(opt::pow(posf, xf), std::pow(posf, xf)), 1.0F));
+
+            expect(le(error(opt::exp(x), std::exp(x)), 2.0));
+            expect(le(error(opt::sin(x), std::sin(x)), 2.0));
+            expect(le(error(opt::cos(x), std::cos(x)), 2.0));
+            expect(le(error(opt::tan(x), std::tan(x)), 4.0));
+            expect(le(error(opt::tanh(x), std::tanh(x)), 4.0));
+            expect(le(error(opt::log(pos), std::log(pos)), 2.0));
+            expect(le(error(opt::log1p(pos), std::log1p(pos)), 2.0));
+            expect(le(error(opt::pow(pos, x), std::pow(pos, x)), 2.0));
+            expect(eq(opt::sqrt(pos), std::sqrt(pos)));
+        }
+    };
+
+    test("math elementary special values") = [] {
+        constexpr auto inf = std::numeric_limits<double>::infinity();
+        constexpr auto nan = std::numeric_limits<double>::quiet_NaN();
+        const auto is_nan = [](double x) { return x != x; };
+
+        expect(constant<opt::exp(-inf) == 0.0>);
+        expect(constant<opt::exp(800.0) == inf>);
+        expect(constant<opt::exp(-800.0) == 0.0>);
+        expect(constant<opt::exp(100.0F) ==
+                        std::numeric_limits<float>::infinity()>);
+        expect(constant<opt::log(0.0) == -inf>);
+        expect(constant<opt::log(inf) == inf>);
+        expect(constant<opt::log(1.0) == 0.0>);
+        expect(constant<opt::log1p(-1.0) == -inf>);
+        expect(constant<opt::tanh(-inf) == -1.0>);
+        expect(constant<opt::pow(-2.0, 3.0) == -8.0>);
+        expect(constant<opt::pow(0.0, -1.0) == inf>);
+        expect(constant<opt::pow(nan, 0.0) == 1.0>);
+
+        expect(is_nan(opt::exp(nan)));
+        expect(is_nan(opt::log(-1.0)));
+        expect(is_nan(opt::log1p(-2.0)));
+        expect(is_nan(opt::sqrt(-1.0)));
+        expect(is_nan(opt::sin(inf)));
+        expect(is_nan(opt::pow(-2.0, 0.5)));
+
+        // Reduction is only accurate for moderate arguments, larger ones are
+        // passed to <cmath> outside of constant evaluation
+        expect(eq(opt::sin(1e10), std::sin(1e10)));
+        expect(constant<opt::sin(1e10) != opt::sin(1e10)>);
+    };
+
+    test("math elementary derivatives") = [tol] {
+        constexpr dual y{0.5F, 1.0F, 1.0F, 0.0F};
+
+        expect(constant<opt::close_to(
+                   opt::log(y), dual{opt::log(0.5F), 2.0F, 2.0F, -4.0F}, tol)>);
+        expect(constant<opt::close_to(
+                   opt::sqrt(y),
+                   dual{opt::sqrt(0.5F),
+                        0.5F / opt::sqrt(0.5F),
+                        0.5F / opt::sqrt(0.5F),
+                        -0.25F / (0.5F * opt::sqrt(0.5F))},
+                   tol)>);
+        expect(constant<opt::close_to(
+                   opt::log1p(y),
+                   dual{opt::log1p(0.5F),
+                        1.0F / 1.5F,
+                        1.0F / 1.5F,
+                        -1.0F / 2.25F},
+                   tol)>);
+        expect(constant<opt::close_to(
+                   opt::pow(y, dual{3.0F}), y * y * y, tol)>);
+
+        const auto t = std::tan(0.5F);
+        expect(opt::close_to(
+            opt::tan(y),
+            dual{t, 1.0F + t * t, 1.0F + t * t, 2.0F * t * (1.0F + t * t)},
+            tol));
+        const auto h = std::tanh(0.5F);
+        expect(opt::close_to(
+            opt::tanh(y),
+            dual{h, 1.0F - h * h, 1.0F - h * h, -2.0F * h * (1.0F - h * h)},
+            tol));
+    };
+
+    test("math abs min max") = [] {
+        constexpr dual a{-1.5F, 1.0F, 2.0F, 3.0F};
+        constexpr dual b{0.5F, 4.0F, 5.0F, 6.0F};
+
+        expect(constant<opt::abs(a) == -a>);
+        expect(constant<opt::abs(b) == b>);
+        expect(constant<opt::abs(-2.0) == 2.0>);
+        expect(constant<opt::min(a, b) == a>);
+        expect(constant<opt::max(a, b) == b>);
+        expect(constant<opt::min(b, b) == b>);
+        expect(constant<opt::max(1.0F, 2.0F) == 2.0F>);
+    };
+
+    test("math sigmoid softplus") = [tol] {
+        const auto s = 1.0F / (1.0F + std::exp(-0.5F));
+        constexpr dual y{0.5F, 1.0F, 1.0F, 0.0F};
+
+        expect(opt::close_to(opt::sigmoid(y),
+                             dual{s,
+                                  s * (1.0F - s),
+                                  s * (1.0F - s),
+                                  s * (1.0F - s) * (1.0F - 2.0F * s)},
+                             tol));
+        expect(opt::close_to(
+            opt::softplus(y),
+            dual{std::log1p(std::exp(0.5F)), s, s, s * (1.0F - s)},
+            tol));
+
+        // No overflow for large arguments
+        expect(constant<opt::sigmoid(1000.0) == 1.0>);
+        expect(constant<opt::sigmoid(-1000.0) == 0.0>);
+        expect(constant<(opt::sigmoid(-50.0) > 0.0)>);
+        expect(constant<opt::softplus(1000.0) == 1000.0>);
+        expect(constant<opt::softplus(-1000.0) == 0.0>);
+    };
+
+    test("math pow real exponent") = [tol] {
+        // Negative bases are allowed with integer exponents
+        constexpr dual y{-1.5F, 1.0F, 1.0F, 0.0F};
+        expect(constant<opt::close_to(
+                   opt::pow(y, 2.0F), dual{2.25F, -3.0F, -3.0F, 2.0F}, tol)>);
+        expect(constant<opt::close_to(
+                   opt::pow(y, 3.0F), y * y * y, tol)>);
+
+        // At zero, derivatives with a zero coefficient are zero and not NaN
+        constexpr dual o{0.0F, 1.0F, 1.0F, 0.0F};
+        expect(constant<opt::pow(o, 1.0F) == o>);
+        expect(constant<opt::pow(o, 0.0F) == dual{1.0F}>);
+        expect(constant<(opt::pow(o, 2.0F) == dual{0.0F, 0.0F, 0.0F, 2.0F})>);
+
+        constexpr dual z{0.5F, 1.0F, 1.0F, 0.0F};
+        const auto l = std::log(2.0F);
+        const auto f = std::pow(2.0F, 0.5F);
+        expect(opt::close_to(
+            opt::pow(2.0F, z), dual{f, f * l, f * l, f * l * l}, tol));
+    };
+
+    test("math log_sum_exp") = [tol] {
+        constexpr auto xs = std::array{1.0, 2.0, 3.0};
+        const auto expected = std::log(std::exp(1.0) + std::exp(2.0) +
+                                       std::exp(3.0));
+        expect(le(std::abs(opt::log_sum_exp(xs) - expected), 1e-15));
+
+        // Stable for large and small elements
+        expect(constant<opt::log_sum_exp(std::array{1000.0, 1000.0}) ==
+                        1000.0 + opt::log(2.0)>);
+        expect(constant<opt::log_sum_exp(std::array{-1000.0}) == -1000.0>);
+
+        constexpr auto inf = std::numeric_limits<double>::infinity();
+        expect(eq(opt::log_sum_exp(std::vector<double>{}), -inf));
+        expect(eq(opt::log_sum_exp(std::array{-inf, 1.0}), 1.0));
+        expect(eq(opt::log_sum_exp(std::array{2.0, inf}), inf));
+
+        // The gradient is given by the softmax weights and the Hessian by
+        // diag(w) - w w^T
+        constexpr auto ys = std::array{dual{1.0F, 1.0F, 0.0F, 0.0F},
+                                       dual{2.0F, 0.0F, 1.0F, 0.0F}};
+        const auto w1 = 1.0F / (1.0F + std::exp(1.0F));
+        const auto w2 = 1.0F - w1;
+        expect(opt::close_to(
+            opt::log_sum_exp(ys),
+            dual{std::log(std::exp(1.0F) + std::exp(2.0F)), w1, w2, -w1 * w2},
+            tol));
+    };
 }
 
 // NOLINTEND(readability-magic-numbers)
@@ -1,7 +1,10 @@
 #include "src/matrix_ops.hpp"
+#include "src/spaces.hpp"
 
 #include "boost/ut.hpp"
 
+#include <limits>
+
 // NOLINTBEGIN(readability-magic-numbers)
 
 auto main() -> int
@@ -35,6 +38,128 @@ auto main() -> int
         // clang-format on
         expect(constant<eq(trace(m), 6.0F)>);
     };
+
+    test("matrix cholesky") = [] {
+        // clang-format off
+        constexpr matrix<vec, 3> m{
+            4.0F, 2.0F, -2.0F,
+            2.0F, 10.0F, 2.0F,
+            -2.0F, 2.0F, 6.0F};
+        // clang-format on
+        constexpr auto l = [m] {
+            auto r = m;
+            static_cast<void>(cholesky(r));
+            return r;
+        }();
+
+        expect(constant<[m] {
+            auto r = m;
+            return cholesky(r);
+        }()>);
+        expect(constant<eq(l[{0, 0}], 2.0F)>);
+        expect(constant<eq(l[{1, 0}], 1.0F)>);
+        expect(constant<eq(l[{2, 0}], -1.0F)>);
+        expect(constant<eq(l[{1, 1}], 3.0F)>);
+        expect(constant<eq(l[{2, 1}], 1.0F)>);
+        expect(constant<eq(l[{2, 2}], 2.0F)>);
+
+        constexpr vec x{1.0F, -2.0F, 3.0F};
+        expect(constant<opt::close_to(cholesky_solve(l, m * x), x, 1e-6F)>);
+    };
+
+    test("matrix cholesky indefinite") = [] {
+        // clang-format off
+        constexpr matrix<vec, 3> m{
+            1.0F, 2.0F, 0.0F,
+            2.0F, 1.0F, 0.0F,
+            0.0F, 0.0F, 1.0F};
+        // clang-format on
+
+        expect(constant<not[m] {
+            auto r = m;
+            return cholesky(r);
+        }()>);
+    };
+
+    test("matrix modified cholesky") = [] {
+        // clang-format off
+        constexpr matrix<vec, 3> spd{
+            4.0F, 2.0F, -2.0F,
+            2.0F, 10.0F, 2.0F,
+            -2.0F, 2.0F, 6.0F};
+        constexpr matrix<vec, 3> indefinite{
+            1.0F, 2.0F, 0.0F,
+            2.0F, 1.0F, 0.0F,
+            0.0F, 0.0F, -3.0F};
+        // clang-format on
+
+        expect(constant<eq(
+                   [spd] {
+                       auto r = spd;
+                       return modified_cholesky(r);
+                   }(),
+                   0.0F)>);
+
+        // The eigenvalues are 3, -1 and -3
+        constexpr auto tau = [indefinite] {
+            auto r = indefinite;
+            return modified_cholesky(r);
+        }();
+        expect(constant<gt(tau, 3.0F)>);
+        expect(constant<lt(tau, 12.0F)>);
+
+        // Fails without looping forever on NaN entries
+        constexpr auto nan = std::numeric_limits<float>::quiet_NaN();
+        // clang-format off
+        constexpr matrix<vec, 3> nan_diagonal{
+            nan, 0.0F, 0.0F,
+            0.0F, 1.0F, 0.0F,
+            0.0F, 0.0F, 1.0F};
+        constexpr matrix<vec, 3> nan_off_diagonal{
+            1.0F, nan, 0.0F,
+            nan, 1.0F, 0.0F,
+            0.0F, 0.0F, 1.0F};
+        // clang-format on
+        constexpr auto failed = [](matrix<vec, 3> r) {
+            const auto t = modified_cholesky(r);
+            return t != t;
+        };
+        expect(constant<failed(nan_diagonal)>);
+        expect(constant<failed(nan_off_diagonal)>);
+    };
+
+    test("matrix ldlt") = [] {
+        // clang-format off
+        constexpr matrix<vec, 3> m{
+            1.0F, 2.0F, 0.0F,
+            2.0F, 1.0F, 0.0F,
+            0.0F, 0.0F, -3.0F};
+        // clang-format on
+        constexpr auto ld = [m] {
+            auto r = m;
+            static_cast<void>(ldlt(r));
+            return r;
+        }();
+
+        expect(constant<eq(ld[{0, 0}], 1.0F)>);
+        expect(constant<eq(ld[{1, 0}], 2.0F)>);
+        expect(constant<eq(ld[{1, 1}], -3.0F)>);
+        expect(constant<eq(ld[{2, 2}], -3.0F)>);
+
+        constexpr vec x{1.0F, -2.0F, 3.0F};
+        expect(constant<opt::close_to(ldlt_solve(ld, m * x), x, 1e-6F)>);
+
+        // clang-format off
+        constexpr matrix<vec, 3> singular{
+            1.0F, 1.0F, 0.0F,
+            1.0F, 1.0F, 0.0F,
+            0.0F, 0.0F, 1.0F};
+        // clang-format on
+        expect(constant<not[singular] {
+            auto r = singular;
+            return ldlt(r);
+        }()>);
+    };
 }
 
 // NOLINTEND(readability-magic-numbers)
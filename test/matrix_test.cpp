@@ -3,11 +3,54 @@
 
 #include "boost/ut.hpp"
 
+#include <cstddef>
+#include <memory>
+#include <utility>
+
 // NOLINTBEGIN(readability-magic-numbers)
 
 template <class T, std::size_t Rows, std::size_t Cols>
 using mat = opt::matrix<opt::vector<T, Rows>, Cols>;
 
+namespace {
+
+// Small integers, so that products and sums are exact in any order
+template <class T, std::size_t Rows, std::size_t Cols>
+auto make_matrix(std::size_t seed) -> std::unique_ptr<mat<T, Rows, Cols>>
+{
+    auto m = std::make_unique<mat<T, Rows, Cols>>();
+    for (std::size_t j{0}; j < Cols; ++j) {
+        for (std::size_t i{0}; i < Rows; ++i) {
+            const auto r = static_cast<int>((i * 7 + j * 3 + seed) % 5);
+            (*m)[{i, j}] = static_cast<T>(r - 2);
+        }
+    }
+    return m;
+}
+
+template <class T, std::size_t M, std::size_t K, std::size_t N>
+auto blocked_product_is_exact() -> bool
+{
+    const auto a = make_matrix<T, M, K>(1);
+    const auto b = make_matrix<T, K, N>(2);
+    const auto c = std::make_unique<mat<T, M, N>>(*a * *b);
+
+    for (std::size_t j{0}; j < N; ++j) {
+        for (std::size_t i{0}; i < M; ++i) {
+            auto expected = T{};
+            for (std::size_t k{0}; k < K; ++k) {
+                expected += (*a)[{i, k}] * (*b)[{k, j}];
+            }
+            if ((*c)[{i, j}] != expected) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
 auto main() -> int
 {
     using namespace boost::ut;
@@ -111,6 +154,32 @@ auto main() -> int
         // clang-format on
         expect(constant<eq(m0 * m1, expected)>);
     };
+
+    test("matrix product blocked") = [] {
+        // Partial micro tiles
+        expect(blocked_product_is_exact<float, 37, 29, 13>());
+        expect(blocked_product_is_exact<double, 37, 29, 13>());
+
+        // Several blocks along every dimension, past `mc`, `kc` and `nc`
+        expect(blocked_product_is_exact<float, 133, 300, 2053>());
+        expect(blocked_product_is_exact<double, 133, 300, 2053>());
+
+        // Equal to the constexpr path
+        constexpr auto product = [] {
+            auto a = mat<double, 17, 17>{};
+            auto b = mat<double, 17, 17>{};
+            for (std::size_t j{0}; j < 17; ++j) {
+                for (std::size_t i{0}; i < 17; ++i) {
+                    a[{i, j}] = static_cast<double>(i) - static_cast<double>(j);
+                    b[{i, j}] = static_cast<double>(i * j % 3);
+                }
+            }
+            return std::pair{a, a * b};
+        };
+        constexpr auto expected = product();
+        auto runtime = product();
+        expect(eq(runtime.second, expected.second));
+    };
 }
 
 // NOLINTEND(readability-magic-numbers)
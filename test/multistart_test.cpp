@@ -0,0 +1,153 @@
+#include "src/multistart.hpp"
+#include "src/spaces.hpp"
+
+#include "boost/ut.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <execution>
+#include <span>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+namespace {
+
+/// Two basins, around x0 = -2 with a value close to -2 and around x0 = 2
+/// with a value close to 2, evaluated on real and dual points, one at a
+/// time or in batches
+///
+/// Counts the batches of real points in `*batches`.
+struct batched_wells {
+    std::size_t* batches;
+
+    template <opt::Point P>
+        requires(opt::Dual<opt::scalar_t<P>> or
+                 std::floating_point<opt::scalar_t<P>>)
+    constexpr auto operator()(const P& x) const -> opt::scalar_t<P>
+    {
+        using T = opt::scalar_t<P>;
+
+        const auto a = x[0] * x[0] - T{4};
+        return a * a + x[0] + x[1] * x[1];
+    }
+
+    template <opt::Point P>
+    constexpr auto operator()(std::span<const P> xs,
+                              std::span<opt::scalar_t<P>> ys) const -> void
+    {
+        if constexpr (std::floating_point<opt::scalar_t<P>>) {
+            ++*batches;
+        }
+        std::ranges::transform(
+            xs, ys.begin(), [this](const P& x) { return (*this)(x); });
+    }
+};
+
+}  // namespace
+
+auto main() -> int
+{
+    using namespace boost::ut;
+    using opt::point;
+
+    // Two basins, around x0 = -2 with a value close to -2 and around x0 = 2
+    // with a value close to 2
+    constexpr auto two_wells = []<opt::Point P>(const P& x) {
+        using T = opt::scalar_t<P>;
+
+        const auto a = x[0] * x[0] - T{4};
+        return a * a + x[0] + x[1] * x[1];
+    };
+
+    const auto grid = [] {
+        auto starts = std::vector<point<double, 2>>{};
+        for (int i{-6}; i <= 6; ++i) {
+            for (int j{-2}; j <= 2; ++j) {
+                starts.push_back({0.5 * i, 0.5 * j});
+            }
+        }
+        return starts;
+    }();
+
+    test("multistart finds the global minimum") = [&] {
+        const auto r = opt::multistart_optimize(grid, two_wells);
+
+        expect(lt(r.x[0], -2.0));
+        expect(gt(r.x[0], -2.1));
+        expect(lt(std::abs(r.x[1]), 1e-6));
+        expect(eq(r.value, two_wells(r.x)));
+        expect(eq(r.starts.size(), grid.size()));
+        expect(eq(r.starts[r.best_start].value, r.value));
+        expect(not r.starts[r.best_start].abandoned);
+    };
+
+    test("multistart per start statistics") = [&] {
+        const auto r =
+            opt::multistart_optimize(grid, two_wells, std::execution::seq);
+
+        for (const auto& s : r.starts) {
+            expect(s.converged or s.abandoned);
+            expect(ge(s.cost_evaluations, s.iterations + 1));
+            expect(ge(s.gradient_evaluations, std::size_t{1}));
+            expect(not(s.value < r.value));
+        }
+    };
+
+    test("multistart abandons dominated starts") = [&] {
+        // In order, the first start reaches the left basin before the starts
+        // on the right begin
+        auto starts = std::vector<point<double, 2>>{
+            {-2.2, 0.0}, {1.97, 0.0}, {2.5, 1.0}, {-1.9, 0.5}};
+
+        const auto r = opt::multistart_optimize(
+            starts, two_wells, std::execution::seq, {.abandon_after = 0});
+        expect(eq(r.best_start, std::size_t{0}) or
+               eq(r.best_start, std::size_t{3}));
+        expect(not r.starts[0].abandoned);
+        expect(r.starts[1].abandoned);
+        expect(r.starts[2].abandoned);
+        expect(not r.starts[3].abandoned);
+        expect(eq(r.starts[1].iterations, std::size_t{0}));
+
+        // Without abandoning, the right minimum is reached too
+        const auto all = opt::multistart_optimize(
+            starts,
+            two_wells,
+            std::execution::seq,
+            {.abandon_after = 1000});
+        expect(all.starts[1].converged);
+        expect(gt(all.starts[1].value, 1.0));
+        expect(lt(std::abs(all.value - r.value), 1e-12));
+    };
+
+    test("multistart batch cost") = [&] {
+        auto batches = std::size_t{};
+        const auto wells = batched_wells{&batches};
+        static_assert(opt::BatchCost<batched_wells, point<double, 2>>);
+
+        // 65 starts, evaluated in two batches before any start runs
+        const auto batched =
+            opt::multistart_optimize(grid, wells, std::execution::seq);
+        expect(eq(batches, std::size_t{2}));
+
+        const auto plain =
+            opt::multistart_optimize(grid, two_wells, std::execution::seq);
+        expect(lt(std::abs(batched.value - plain.value), 1e-12));
+        expect(not batched.starts[batched.best_start].abandoned);
+    };
+
+    test("multistart parallel matches sequential") = [&] {
+        const auto seq =
+            opt::multistart_optimize(grid, two_wells, std::execution::seq);
+        const auto par =
+            opt::multistart_optimize(grid, two_wells, std::execution::par);
+
+        expect(lt(std::abs(seq.value - par.value), 1e-12));
+        expect(opt::close_to(seq.x, par.x, 1e-6));
+    };
+}
+
+// NOLINTEND(readability-magic-numbers)
@@ -0,0 +1,179 @@
+#include "src/convopt.hpp"
+#include "src/math.hpp"
+#include "src/newton.hpp"
+#include "src/spaces.hpp"
+
+#include "boost/ut.hpp"
+
+#include <cstddef>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+auto main() -> int
+{
+    using namespace boost::ut;
+    using opt::point;
+
+    constexpr auto cost = []<opt::Point P>(const P& x) {
+        using T = opt::scalar_t<P>;
+
+        return opt::exp((x[0] - T{3}) * (x[0] - T{3})) +
+               (x[1] + T{1}) * (x[1] + T{1});
+    };
+
+    constexpr auto rosenbrock = []<opt::Point P>(const P& x) {
+        using T = opt::scalar_t<P>;
+
+        const auto a = T{1} - x[0];
+        const auto b = x[1] - x[0] * x[0];
+        return a * a + T{100} * b * b;
+    };
+
+    constexpr auto quadratic = []<opt::Point P>(const P& x) {
+        using T = opt::scalar_t<P>;
+
+        const auto a = x[0] - T{1};
+        const auto b = x[1] + T{2};
+        return T{3} * a * a + a * b + T{10} * b * b;
+    };
+
+    test("newton quadratic") = [&] {
+        // A single full step reaches the minimum
+        constexpr auto r = opt::newton(
+            point{10.0, 10.0},
+            quadratic,
+            {.gradient_tolerance = 1e-8, .max_iterations = 1});
+        expect(constant<eq(r.iterations, std::size_t{1})>);
+        expect(constant<opt::close_to(r.x, point{1.0, -2.0}, 1e-12)>);
+    };
+
+    test("newton test cost") = [&] {
+        constexpr point p{2.0F, 0.0F};
+
+        expect(constant<opt::close_to(
+                   opt::newton(p, cost).x, point{3.0F, -1.0F}, 1e-2F)>);
+        expect(constant<opt::close_to(
+                   opt::newton<opt::strong_wolfe>(p, cost).x,
+                   point{3.0F, -1.0F},
+                   1e-2F)>);
+    };
+
+    test("newton cost evaluations") = [&] {
+        auto n = std::size_t{};
+        const auto counted = [&n, &cost]<opt::Point P>(const P& x) {
+            ++n;
+            return cost(x);
+        };
+
+        // Counts evaluations on dual numbers for derivatives too
+        const auto r =
+            opt::newton(point{2.0, 0.0}, counted, {.gradient_tolerance = 1e-8});
+        expect(r.reason == opt::stop_reason::gradient_tolerance);
+        expect(opt::close_to(r.x, point{3.0, -1.0}, 1e-6));
+        expect(lt(n, std::size_t{50}));
+    };
+
+    test("newton rosenbrock") = [&] {
+        constexpr auto tight =
+            opt::solver_options<double>{.gradient_tolerance = 1e-8};
+
+        expect(constant<opt::close_to(
+                   opt::newton(point{-1.2, 1.0}, rosenbrock, tight).x,
+                   point{1.0, 1.0},
+                   1e-6)>);
+
+        // The Hessian is indefinite at the start
+        expect(constant<opt::close_to(
+                   opt::newton(point{0.0, 1.0}, rosenbrock, tight).x,
+                   point{1.0, 1.0},
+                   1e-6)>);
+    };
+
+    test("newton undefined hessian") = [] {
+        // The cost and its derivatives are NaN at the start
+        const auto p = point{-1.0, 1.0};
+        const auto undefined = []<opt::Point P>(const P& x) {
+            return opt::sqrt(x[0]) + x[1] * x[1];
+        };
+        for (const auto& r :
+             {opt::newton(p, undefined), opt::sparse_newton(p, undefined)}) {
+            expect(eq(r.x, p));
+            expect(r.reason == opt::stop_reason::factorization_failed);
+        }
+    };
+
+    test("newton sparse") = [] {
+        // Chained Rosenbrock, with a tridiagonal Hessian
+        constexpr auto chained = []<opt::Point P>(const P& x) {
+            using T = opt::scalar_t<P>;
+
+            auto acc = T{};
+            for (std::size_t i{0}; i + 1 < opt::dimension(x); ++i) {
+                const auto a = T{1} - x[i];
+                const auto b = x[i + 1] - x[i] * x[i];
+                acc += a * a + T{100} * b * b;
+            }
+            return acc;
+        };
+
+        // Converges to a local minimum other than (1, ..., 1), as the dense
+        // method
+        const auto p = point{-1.2, 1.0, -1.2, 1.0, -1.2, 1.0};
+        const auto tight =
+            opt::solver_options<double>{.gradient_tolerance = 1e-10};
+        expect(opt::close_to(opt::sparse_newton(p, chained, tight).x,
+                             opt::newton(p, chained, tight).x,
+                             1e-8));
+
+        auto start = opt::dyn_point<double>(500);
+        for (std::size_t i{0}; i < start.size(); ++i) {
+            start[i] = i % 3 == 0 ? 1.3 : 0.8;
+        }
+        const auto y = opt::sparse_newton(start, chained, tight);
+        expect(y.converged());
+        expect(opt::close_to(y.x, opt::dyn_point<double>(500, 1.0), 1e-8));
+    };
+    test("newton cg") = [&] {
+        constexpr auto tight =
+            opt::solver_options<double>{.gradient_tolerance = 1e-8};
+
+        expect(constant<opt::close_to(
+                   opt::newton_cg(point{-1.2, 1.0}, rosenbrock, tight).x,
+                   point{1.0, 1.0},
+                   1e-6)>);
+
+        // Negative curvature along the steepest descent direction at the
+        // start
+        expect(constant<opt::close_to(
+                   opt::newton_cg(point{0.0, 1.0}, rosenbrock, tight).x,
+                   point{1.0, 1.0},
+                   1e-6)>);
+        expect(constant<opt::close_to(
+                   opt::newton_cg(point{10.0, 10.0}, quadratic, tight).x,
+                   point{1.0, -2.0},
+                   1e-8)>);
+
+        // Points of dynamic size, the Hessian never being formed
+        constexpr auto chained = []<opt::Point P>(const P& x) {
+            using T = opt::scalar_t<P>;
+
+            auto acc = T{};
+            for (std::size_t i{0}; i + 1 < opt::dimension(x); ++i) {
+                const auto a = T{1} - x[i];
+                const auto b = x[i + 1] - x[i] * x[i];
+                acc += a * a + T{100} * b * b;
+            }
+            return acc;
+        };
+        auto start = opt::dyn_point<double>(300);
+        for (std::size_t i{0}; i < start.size(); ++i) {
+            start[i] = i % 3 == 0 ? 1.3 : 0.8;
+        }
+        const auto y = opt::newton_cg(
+            start, chained, {.gradient_tolerance = 1e-10});
+        expect(y.reason == opt::stop_reason::gradient_tolerance);
+        expect(opt::close_to(y.x, opt::dyn_point<double>(300, 1.0), 1e-8));
+    };
+}
+
+// NOLINTEND(readability-magic-numbers)
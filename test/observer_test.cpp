@@ -0,0 +1,142 @@
+#include "src/convopt.hpp"
+#include "src/math.hpp"
+#include "src/observer.hpp"
+#include "src/spaces.hpp"
+
+#include "boost/ut.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+auto main() -> int
+{
+    using namespace boost::ut;
+    using opt::point;
+
+    constexpr auto cost = []<opt::Point P>(const P& x) {
+        using T = opt::scalar_t<P>;
+
+        return opt::exp((x[0] - T{3}) * (x[0] - T{3})) +
+               (x[1] + T{1}) * (x[1] + T{1});
+    };
+
+    constexpr point p{2.0F, 0.0F};
+    using P = point<float, 2>;
+
+    test("observer ignored by default") = [&] {
+        expect(constant<opt::optimize(p, cost, {}, opt::no_observer{}).x ==
+                        opt::optimize(p, cost).x>);
+
+        // Observers that only take iteration events are not timed
+        constexpr auto iterations = [cost, p] {
+            auto n = std::size_t{};
+            opt::optimize(
+                p, cost, {}, [&n](const opt::iteration_event<P>&) { ++n; });
+            return n;
+        };
+        expect(constant<(iterations() > 1)>);
+    };
+
+    test("observer iteration events") = [&] {
+        auto events = std::vector<opt::iteration_event<P>>{};
+        auto points = std::vector<P>{};
+
+        const auto x =
+            opt::optimize(p,
+                          cost,
+                          {},
+                          [&events, &points](const opt::iteration_event<P>& e) {
+                              events.push_back(e);
+                              points.push_back(e.x);
+                          })
+                .x;
+
+        expect(ge(events.size(), std::size_t{2}) >> fatal);
+        expect(eq(events.front().iteration, std::size_t{0}));
+        expect(eq(points.front(), p));
+        expect(eq(events.front().step, 0.0F));
+        expect(eq(events.front().cost_evaluations, std::size_t{1}));
+        expect(eq(points.back(), x));
+
+        for (std::size_t i{1}; i < events.size(); ++i) {
+            expect(eq(events[i].iteration, i));
+            expect(gt(events[i].step, 0.0F));
+            expect(lt(events[i].value, events[i - 1].value));
+            expect(gt(events[i].cost_evaluations,
+                      events[i - 1].cost_evaluations));
+        }
+        expect(lt(events.back().gradient_norm, events.front().gradient_norm));
+    };
+
+    test("observer stops early") = [&] {
+        auto n = std::size_t{};
+        const auto r =
+            opt::optimize(p, cost, {}, [&n](const opt::iteration_event<P>& e) {
+                n = e.iteration;
+                return e.iteration == 1 ? opt::control::stop
+                                        : opt::control::proceed;
+            });
+
+        expect(eq(n, std::size_t{1}));
+        expect(r.reason == opt::stop_reason::observer);
+        expect(eq(r.iterations, std::size_t{1}));
+        expect(neq(r.x, p));
+        expect(neq(r.x, opt::optimize(p, cost).x));
+
+        const auto at_start =
+            opt::optimize(p, cost, {}, [](const opt::iteration_event<P>&) {
+                return opt::control::stop;
+            });
+        expect(eq(at_start.x, p));
+    };
+
+    test("observer stats") = [&] {
+        auto stats = opt::solver_stats{};
+        opt::optimize(p, cost, {}, opt::stats_recorder{&stats});
+
+        expect(gt(stats.iterations, std::size_t{0}));
+        // Including the gradients evaluated by the line searches
+        expect(eq(stats.gradients, stats.gradient_evaluations));
+        expect(eq(stats.line_searches, stats.iterations));
+        expect(eq(stats.hessians, std::size_t{0}));
+        expect(ge(stats.cost_evaluations, stats.iterations + 1));
+        expect(ge(stats.gradient_evaluations, stats.iterations + 1));
+        expect(gt(stats.line_search_time.count(), 0));
+
+        opt::hessian(p, cost, opt::serial{}, opt::stats_recorder{&stats});
+        expect(eq(stats.hessians, std::size_t{1}));
+    };
+
+    test("observer phase events") = [&] {
+        auto events = std::vector<opt::phase_event>{};
+        const auto record = [&events](const opt::phase_event& e) {
+            events.push_back(e);
+        };
+
+        expect(eq(opt::gradient(p, cost, opt::serial{}, record),
+                  opt::gradient(p, cost)));
+        expect(eq(opt::hessian(p, cost, opt::serial{}, record),
+                  opt::hessian(p, cost)));
+
+        const auto g = opt::gradient(p, cost);
+        const auto step = opt::line_search(
+            p, -g, cost, cost(p), g, opt::more_thuente{}, record);
+
+        // The gradients of the line search come before its own event
+        const auto n = step.gradient_evaluations;
+        expect(eq(events.size(), n + 3) >> fatal);
+        expect(events[0].phase == opt::phase::gradient);
+        expect(events[1].phase == opt::phase::hessian);
+        for (std::size_t i{0}; i < n; ++i) {
+            expect(events[i + 2].phase == opt::phase::gradient);
+        }
+        const auto& search = events[n + 2];
+        expect(search.phase == opt::phase::line_search);
+        expect(eq(search.cost_evaluations, step.cost_evaluations));
+        expect(eq(search.gradient_evaluations, step.gradient_evaluations));
+    };
+}
+
+// NOLINTEND(readability-magic-numbers)
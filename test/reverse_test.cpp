@@ -0,0 +1,95 @@
+#include "src/convopt.hpp"
+#include "src/math.hpp"
+#include "src/reverse.hpp"
+#include "src/spaces.hpp"
+
+#include "boost/ut.hpp"
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+auto main() -> int
+{
+    using namespace boost::ut;
+    using opt::adjoint;
+    using opt::point;
+    using opt::vector;
+
+    test("reverse arithmetic") = [] {
+        auto t = opt::tape<float>{};
+
+        const auto x = adjoint<float>{2.0F, t, t.variable()};
+        const auto y = adjoint<float>{-3.0F, t, t.variable()};
+
+        const auto z = (x * y - x / y) + adjoint<float>{1.0F} * (-y);
+        expect(eq(z.value, -6.0F + 2.0F / 3.0F + 3.0F));
+
+        t.backward(z.index);
+        expect(eq(t.adjoint(x.index), -3.0F + 1.0F / 3.0F));
+        expect(eq(t.adjoint(y.index), 2.0F + 2.0F / 9.0F - 1.0F));
+    };
+
+    test("reverse constants are not recorded") = [] {
+        auto t = opt::tape<float>{};
+        const auto z = adjoint<float>{2.0F} * adjoint<float>{3.0F};
+
+        expect(eq(z.value, 6.0F));
+        expect(z.recorder == nullptr);
+        expect(eq(t.size(), std::size_t{}));
+    };
+
+    test("reverse math") = [] {
+        auto t = opt::tape<float>{};
+        const auto x = adjoint<float>{1.0F, t, t.variable()};
+
+        const auto z = opt::sin(x * x);
+        t.backward(z.index);
+
+        const auto d = opt::sin(opt::dual{1.0F, 1.0F, 0.0F, 0.0F} *
+                                opt::dual{1.0F, 1.0F, 0.0F, 0.0F});
+        expect(eq(z.value, d.real));
+        expect(eq(t.adjoint(x.index), d.e1));
+    };
+
+    constexpr auto cost = []<opt::Point P>(const P& x) {
+        using T = opt::scalar_t<P>;
+
+        return opt::exp((x[0] - T{3}) * (x[0] - T{3})) +
+               (x[1] + T{1}) * (x[1] + T{1}) + x[0] * x[1] * x[2];
+    };
+
+    test("reverse gradient") = [&cost] {
+        constexpr point p{2.0F, 0.0F, 0.5F};
+
+        expect(eq(opt::gradient_reverse(p, cost), opt::gradient(p, cost)));
+    };
+
+    test("reverse gradient reuses the tape") = [&cost] {
+        auto t = opt::tape<double>{};
+
+        auto p = point{2.0, 0.0, 0.5};
+        const auto g = opt::gradient_reverse(p, cost, t);
+        const auto capacity = t.capacity();
+
+        for (auto i = 0; i < 10; ++i) {
+            p = p - 0.01 * g;
+            expect(eq(opt::gradient_reverse(p, cost, t), opt::gradient(p, cost)));
+        }
+        expect(eq(t.capacity(), capacity));
+    };
+
+    test("reverse gradient dynamic dimension") = [&cost] {
+        const auto p = opt::dyn_point{{2.0, 0.0, 0.5}};
+
+        expect(eq(opt::gradient_reverse(p, cost), opt::gradient(p, cost)));
+    };
+
+    test("reverse gradient of constant cost") = [] {
+        constexpr auto constant_cost = []<opt::Point P>(const P&) {
+            return opt::scalar_t<P>{42};
+        };
+        expect(eq(opt::gradient_reverse(point{1.0F, 2.0F}, constant_cost),
+                  vector<float, 2>{}));
+    };
+}
+
+// NOLINTEND(readability-magic-numbers)
@@ -0,0 +1,151 @@
+#include "src/convopt.hpp"
+#include "src/math.hpp"
+#include "src/schedule.hpp"
+#include "src/spaces.hpp"
+
+#include "boost/ut.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+namespace {
+
+// Number of times each task is run by `s`
+template <opt::Scheduler S>
+auto task_counts(const S& s, std::size_t n) -> std::vector<std::size_t>
+{
+    auto counts = std::vector<std::atomic<std::size_t>>(n);
+    s(n, [&counts](std::size_t first, std::size_t last) {
+        for (auto i = first; i < last; ++i) {
+            ++counts[i];
+        }
+    });
+    return {counts.begin(), counts.end()};
+}
+
+// Runs the ranges of tasks from the last to the first, one task at a time
+struct reversed {
+    std::size_t* calls{};
+
+    template <class F>
+    auto operator()(std::size_t n, const F& f) const -> void
+    {
+        for (auto i = n; i-- > 0;) {
+            ++*calls;
+            f(i, i + 1);
+        }
+    }
+};
+
+}  // namespace
+
+auto main() -> int
+{
+    using namespace boost::ut;
+    using namespace std::chrono_literals;
+    using opt::point;
+
+    constexpr auto cost = []<opt::Point P>(const P& x) {
+        using T = opt::scalar_t<P>;
+
+        auto acc = T{};
+        for (std::size_t i{0}; i < opt::dimension(x); ++i) {
+            acc += opt::sin(x[i] * T(static_cast<double>(i + 1)));
+        }
+        for (std::size_t i{0}; i + 1 < opt::dimension(x); ++i) {
+            acc += x[i] * x[i + 1] * x[i + 1];
+        }
+        return acc;
+    };
+
+    // Only evaluated with one infinitesimal part per task
+    constexpr auto cost_per_task = [cost]<opt::Point P>(const P& x)
+        requires(not opt::DualVec<opt::scalar_t<P>> and
+                 not opt::DualLanes<opt::scalar_t<P>> and
+                 not opt::HyperDualVec<opt::scalar_t<P>>)
+    {
+        return cost(x);
+    };
+
+    test("schedule every task runs once") = [] {
+        const auto once = [](const auto& counts) {
+            for (auto c : counts) {
+                if (c != 1) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        for (auto n : {std::size_t{0}, std::size_t{1}, std::size_t{97}}) {
+            expect(once(task_counts(opt::serial{}, n)));
+            expect(once(task_counts(opt::parallel{}, n)));
+            expect(once(task_counts(opt::parallel{.grain = 8}, n)));
+            expect(once(task_counts(opt::parallel{.grain = 0}, n)));
+            expect(once(task_counts(opt::adaptive{}, n)));
+            expect(once(task_counts(opt::adaptive{.serial_below = 0ns}, n)));
+        }
+    };
+
+    test("schedule parallel grain") = [] {
+        auto sizes = std::vector<std::size_t>(10);
+        opt::parallel{.grain = 4}(
+            10, [&sizes](std::size_t first, std::size_t last) {
+                sizes[first] = last - first;
+            });
+        expect(eq(sizes[0], std::size_t{4}));
+        expect(eq(sizes[4], std::size_t{4}));
+        expect(eq(sizes[8], std::size_t{2}));
+    };
+
+    test("schedule gradient policies") = [&] {
+        constexpr point p{0.5, -1.0, 2.0, 0.25, 1.5};
+        constexpr auto expected = opt::gradient(p, cost_per_task);
+
+        expect(eq(opt::gradient(p, cost_per_task, opt::serial{}), expected));
+        expect(eq(opt::gradient(p, cost_per_task, opt::parallel{}), expected));
+        expect(eq(opt::gradient(p, cost_per_task, opt::adaptive{}), expected));
+
+        auto calls = std::size_t{};
+        expect(eq(opt::gradient(p, cost_per_task, reversed{&calls}),
+                  expected));
+        expect(eq(calls, std::size_t{5}));
+
+        // Lanes of dual numbers, the dimension is only known at runtime
+        auto q = opt::dyn_point<double>(5);
+        for (std::size_t i{0}; i < 5; ++i) {
+            q[i] = p[i];
+        }
+        const auto lanes = opt::gradient(q, cost, opt::serial{});
+        for (std::size_t i{0}; i < 5; ++i) {
+            expect(eq(lanes[i], expected[i]));
+        }
+        expect(eq(opt::gradient(q, cost, opt::parallel{}), lanes));
+    };
+
+    test("schedule hessian policies") = [&] {
+        constexpr point p{0.5, -1.0, 2.0, 0.25, 1.5};
+        constexpr auto expected = opt::hessian(p, cost_per_task);
+
+        expect(eq(opt::hessian(p, cost_per_task, opt::serial{}), expected));
+        expect(eq(opt::hessian(p, cost_per_task, opt::parallel{.grain = 2}),
+                  expected));
+
+        auto calls = std::size_t{};
+        expect(
+            eq(opt::hessian(p, cost_per_task, reversed{&calls}), expected));
+        expect(eq(calls, std::size_t{15}));
+
+        // Parallel after timing the first entry
+        expect(eq(opt::hessian(p,
+                               cost_per_task,
+                               opt::adaptive{.serial_below = 0ns}),
+                  expected));
+    };
+}
+
+// NOLINTEND(readability-magic-numbers)
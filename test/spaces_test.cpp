@@ -2,6 +2,9 @@
 
 #include "boost/ut.hpp"
 
+#include <cstdint>
+#include <memory>
+#include <span>
 #include <type_traits>
 
 // NOLINTBEGIN(readability-magic-numbers)
@@ -45,6 +48,44 @@ auto main() -> int
         expect(constant<opt::norm(v) == 5._f>);
     };
 
+    test("spaces vector dot") = [] {
+        constexpr vector v1{2.0F, 0.0F, -1.0F};
+        constexpr vector v2{1.0F, 5.0F, 3.0F};
+
+        expect(constant<opt::dot(v1, v2) == -1._f>);
+        expect(eq(opt::dot(v1, v2), -1.0F));
+        expect(eq(opt::dot(v1, v1), opt::norm(v1)));
+    };
+
+    test("spaces vectorized operations") = [] {
+        constexpr auto make = [](double offset) {
+            auto v = vector<double, 37>{};
+            for (std::size_t i{0}; i < 37; ++i) {
+                v[i] = offset + 0.25 * static_cast<double>(i);
+            }
+            return v;
+        };
+        constexpr auto v1 = make(-3.0);
+        constexpr auto v2 = make(1.5);
+        constexpr auto p = point<double, 37>{} + v2;
+
+        // Element-wise operations match the constant evaluated ones exactly
+        constexpr auto sum = v1 + v2;
+        constexpr auto difference = v1 - v2;
+        constexpr auto scaled = 0.3 * v1;
+        constexpr auto moved = p - v1;
+        expect(eq(v1 + v2, sum));
+        expect(eq(v1 - v2, difference));
+        expect(eq(0.3 * v1, scaled));
+        expect(eq(p - v1, moved));
+
+        // Reductions are reassociated
+        constexpr auto n = opt::norm(v1);
+        constexpr auto d = opt::dot(v1, v2);
+        expect(le(opt::norm(v1), n + 1e-9) and ge(opt::norm(v1), n - 1e-9));
+        expect(le(opt::dot(v1, v2), d + 1e-9) and ge(opt::dot(v1, v2), d - 1e-9));
+    };
+
     test("spaces vector and point sum") = [] {
         constexpr point<float, 3> zero{};
         constexpr point p1{1.0F, 0.0F, 0.0F};
@@ -53,6 +94,58 @@ auto main() -> int
         expect(constant<eq(zero + v, p1)>);
         expect(constant<eq(point<float, 3>{} + vector{1.0F, 0.0F, 0.0F}, p1)>);
     };
+
+    using opt::dyn_point;
+    using opt::dyn_vector;
+
+    test("spaces dynamic concepts") = [] {
+        expect(constant<opt::Vector<dyn_vector<float>>>);
+        expect(constant<opt::Point<dyn_point<float>>>);
+        expect(constant<opt::extent_v<dyn_point<float>> == std::dynamic_extent>);
+        expect(constant<opt::extent_v<point<float, 3>> == 3>);
+        expect(constant<not opt::Point<dyn_point<float>, vector<float, 3>>>);
+        expect(constant<opt::Point<dyn_point<float, std::allocator<float>>>>);
+    };
+
+    test("spaces dynamic vector") = [] {
+        constexpr auto ok = [] {
+            const auto zero = dyn_vector<float>(3);
+            const auto v1 = dyn_vector{{1.0F, 0.0F, 0.0F}};
+            const auto v2 = dyn_vector{{1.0F, 0.0F, -1.0F}};
+
+            return v1.size() == 3 and opt::dimension(v1) == 3 and
+                   v1 + zero == v1 and
+                   -v1 == dyn_vector{{-1.0F, 0.0F, 0.0F}} and
+                   v1 + v2 == dyn_vector{{2.0F, 0.0F, -1.0F}} and
+                   v1 - v2 == dyn_vector{{0.0F, 0.0F, 1.0F}} and
+                   3.0F * v2 == dyn_vector{{3.0F, 0.0F, -3.0F}} and
+                   v2 * 3.0F == dyn_vector{{3.0F, 0.0F, -3.0F}} and
+                   opt::norm(v2) == 2.0F;
+        };
+        expect(constant<ok()>);
+    };
+
+    test("spaces dynamic vector and point") = [] {
+        constexpr auto ok = [] {
+            const auto zero = dyn_point<float>(3);
+            const auto p1 = dyn_point{{1.0F, 0.0F, 0.0F}};
+            const auto v = dyn_vector{{1.0F, 0.0F, 0.0F}};
+
+            return zero + v == p1 and v + zero == p1 and p1 - v == zero and
+                   p1 - zero == v and
+                   opt::close_to(p1, dyn_point{{1.0F, 1e-4F, 0.0F}}, 1e-3F) and
+                   not opt::close_to(p1, dyn_point{{1.0F, 1.0F, 0.0F}}, 1e-3F);
+        };
+        expect(constant<ok()>);
+    };
+
+    test("spaces dynamic storage is aligned") = [] {
+        const auto v = dyn_vector<double>(1000);
+        const auto address = reinterpret_cast<std::uintptr_t>(v.data.data());
+
+        expect(eq(address % 64, std::uintptr_t{}));
+        expect(eq(opt::dimension(v), std::size_t{1000}));
+    };
 }
 
 // NOLINTEND(readability-magic-numbers)
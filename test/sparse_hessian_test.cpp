@@ -0,0 +1,157 @@
+#include "src/convopt.hpp"
+#include "src/math.hpp"
+#include "src/sparse_hessian.hpp"
+#include "src/spaces.hpp"
+
+#include "boost/ut.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+auto main() -> int
+{
+    using namespace boost::ut;
+    using opt::point;
+
+    // Each coordinate interacts with its neighbors only, and linearly with
+    // the last one
+    constexpr auto chained = []<opt::Point P>(const P& x) {
+        using T = opt::scalar_t<P>;
+
+        const auto n = opt::dimension(x);
+        auto acc = x[n - 1];
+        for (std::size_t i{0}; i + 1 < n; ++i) {
+            const auto d = x[i + 1] - x[i] * x[i];
+            acc += T{100} * d * d + (T{1} - x[i]) * (T{1} - x[i]);
+            acc += opt::sin(x[i] * x[i + 1]) / (T{2} + x[i + 1] * x[i + 1]);
+        }
+        return acc;
+    };
+    constexpr auto chained_per_entry = [chained]<opt::Point P>(const P& x)
+        requires(not opt::HyperDualVec<opt::scalar_t<P>>)
+    {
+        return chained(x);
+    };
+
+    // The first coordinate interacts with all the others
+    constexpr auto arrowhead = []<opt::Point P>(const P& x) {
+        auto acc = opt::scalar_t<P>{};
+        for (std::size_t i{1}; i < opt::dimension(x); ++i) {
+            acc += opt::exp(x[0] * x[i]);
+        }
+        return acc;
+    };
+
+    using P8 = point<double, 8>;
+    constexpr auto p8 = P8{0.1, -0.3, 0.7, 1.1, -0.9, 0.4, 0.2, -0.5};
+
+    test("sparse hessian pattern") = [&] {
+        const auto s = opt::hessian_sparsity(p8, chained);
+
+        expect(eq(s.rows, std::size_t{8}));
+        expect(eq(s.nonzeros(), std::size_t{8 + 2 * 7}));
+        for (std::size_t i{0}; i < 8; ++i) {
+            for (std::size_t j{0}; j < 8; ++j) {
+                const auto distance = i < j ? j - i : i - j;
+                expect(eq(s.contains(i, j), distance <= 1));
+            }
+        }
+
+        // The last coordinate enters linearly in a term of its own, but not
+        // in the others
+        const auto linear = []<opt::Point P>(const P& x) {
+            return x[0] * x[0] + x[1] + x[2] / x[0];
+        };
+        const auto l = opt::hessian_sparsity(point{1.0, 2.0, 3.0}, linear);
+        expect(eq(l, opt::sparsity_pattern::from_entries(
+                         3, 3, {{0, 0}, {0, 2}, {2, 0}})));
+    };
+
+    test("sparse hessian star coloring") = [&] {
+        // Bands of the chained cost need three colors, with every other
+        // coordinate of the same color, and arrowheads two
+        const auto band =
+            opt::star_coloring(opt::hessian_sparsity(p8, chained));
+        expect(eq(band.count, std::size_t{3}));
+        expect(eq(band.colors,
+                  std::vector<std::size_t>{0, 1, 0, 2, 0, 1, 0, 2}));
+
+        const auto arrow =
+            opt::star_coloring(opt::hessian_sparsity(p8, arrowhead));
+        expect(eq(arrow.count, std::size_t{2}));
+
+        // The path 0 - 3 - 1 - 2 is not bicolored, even though 3 is colored
+        // last and is only adjacent to coordinates of the same color
+        const auto path = opt::sparsity_pattern::from_entries(
+            4, 4, {{0, 3}, {3, 0}, {1, 3}, {3, 1}, {1, 2}, {2, 1}});
+        const auto c = opt::star_coloring(path);
+        expect(eq(c.count, std::size_t{3}));
+        expect(eq(c.colors, std::vector<std::size_t>{0, 0, 1, 2}));
+    };
+
+    test("sparse hessian colored") = [&] {
+        const auto h = opt::sparse_hessian(p8, chained);
+        const auto dense = opt::hessian(p8, chained);
+
+        expect(eq(h.nonzeros(), std::size_t{22}));
+        for (std::size_t i{0}; i < 8; ++i) {
+            for (std::size_t j{0}; j < 8; ++j) {
+                expect(le(opt::stdx::abs(h[{i, j}] - dense[{i, j}]), 1e-12));
+                expect(eq(h[{i, j}], h[{j, i}]));
+            }
+        }
+
+        const auto a = opt::sparse_hessian(p8, arrowhead, opt::serial{});
+        const auto dense_a = opt::hessian(p8, arrowhead);
+        for (std::size_t i{0}; i < 8; ++i) {
+            for (std::size_t j{0}; j < 8; ++j) {
+                expect(
+                    le(opt::stdx::abs(a[{i, j}] - dense_a[{i, j}]), 1e-12));
+            }
+        }
+    };
+
+    test("sparse hessian per entry") = [&] {
+        static_assert(
+            not opt::HyperVectorCost<decltype(chained_per_entry), P8>);
+
+        const auto h = opt::sparse_hessian(p8, chained_per_entry);
+        expect(eq(h, opt::sparse_hessian(p8, chained)));
+
+        // Points of dynamic size, with the pattern reused at another point
+        const auto x = [](double offset) {
+            auto r = opt::dyn_point<double>(40);
+            for (std::size_t i{0}; i < r.size(); ++i) {
+                r[i] = offset + 0.02 * static_cast<double>(i);
+            }
+            return r;
+        };
+        const auto s = opt::hessian_sparsity(x(0.0), chained);
+        expect(eq(s.nonzeros(), std::size_t{40 + 2 * 39}));
+
+        const auto h1 = opt::sparse_hessian(x(0.5), chained, s);
+        expect(eq(h1, opt::sparse_hessian(x(0.5), chained)));
+
+        const auto d = opt::detail::as_point_dual(x(0.5));
+        auto d12 = d;
+        d12[12].e1 = 1;
+        d12[13].e2 = 1;
+        expect(eq((h1[{12, 13}]), chained(d12).e3));
+        expect(eq((h1[{13, 12}]), chained(d12).e3));
+        expect(eq((h1[{12, 14}]), 0.0));
+    };
+
+    test("sparse hessian constexpr") = [&] {
+        constexpr auto entry = [chained] {
+            constexpr auto p = point{0.5, -1.0, 2.0};
+            return opt::sparse_hessian(p, chained)[{0, 1}];
+        };
+        expect(constant<entry() == opt::hessian(point{0.5, -1.0, 2.0},
+                                                chained)[{0, 1}]>);
+    };
+}
+
+// NOLINTEND(readability-magic-numbers)
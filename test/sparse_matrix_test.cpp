@@ -0,0 +1,225 @@
+#include "src/matrix.hpp"
+#include "src/matrix_ops.hpp"
+#include "src/schedule.hpp"
+#include "src/spaces.hpp"
+#include "src/sparse_matrix.hpp"
+#include "src/sparse_matrix_ops.hpp"
+
+#include "boost/ut.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+auto main() -> int
+{
+    using namespace boost::ut;
+    using opt::vector;
+
+    using entries = std::vector<std::pair<std::size_t, std::size_t>>;
+
+    // [4 1 0 0]
+    // [1 5 2 0]
+    // [0 2 6 3]
+    // [0 0 3 7]
+    const auto band = opt::csr_matrix<double>{
+        opt::sparsity_pattern::from_entries(4,
+                                            4,
+                                            {{0, 0},
+                                             {0, 1},
+                                             {1, 0},
+                                             {1, 1},
+                                             {1, 2},
+                                             {2, 1},
+                                             {2, 2},
+                                             {2, 3},
+                                             {3, 2},
+                                             {3, 3}}),
+        {4.0, 1.0, 1.0, 5.0, 2.0, 2.0, 6.0, 3.0, 3.0, 7.0}};
+
+    test("sparse matrix pattern") = [] {
+        const auto p = opt::sparsity_pattern::from_entries(
+            2, 3, {{1, 2}, {0, 1}, {1, 0}, {0, 1}});
+
+        expect(eq(p.nonzeros(), std::size_t{3}));
+        expect(eq(p.offsets, std::vector<std::size_t>{0, 1, 3}));
+        expect(eq(p.indices, std::vector<std::size_t>{1, 0, 2}));
+        expect(p.contains(1, 2));
+        expect(not p.contains(0, 0));
+
+        auto order = std::vector<std::size_t>{};
+        const auto t = p.transpose(&order);
+        expect(eq(t.rows, std::size_t{3}));
+        expect(eq(t.offsets, std::vector<std::size_t>{0, 1, 2, 3}));
+        expect(eq(t.indices, std::vector<std::size_t>{1, 0, 1}));
+        expect(eq(order, std::vector<std::size_t>{1, 0, 2}));
+        expect(eq(t.transpose(), p));
+    };
+
+    test("sparse matrix storage") = [] {
+        const auto m = opt::csr_matrix<double>{
+            opt::sparsity_pattern::from_entries(2, 3, {{0, 1}, {1, 0}, {1, 2}}),
+            {1.0, 2.0, 3.0}};
+
+        const auto c = opt::to_csc(m);
+        expect(eq(c.rows(), std::size_t{2}));
+        expect(eq(c.cols(), std::size_t{3}));
+        for (std::size_t i{0}; i < 2; ++i) {
+            for (std::size_t j{0}; j < 3; ++j) {
+                expect(eq(c[{i, j}], m[{i, j}]));
+            }
+        }
+        expect(eq(c.values, std::vector<double>{2.0, 1.0, 3.0}));
+        expect(eq(opt::to_csr(c), m));
+    };
+
+    test("sparse matrix vector product") = [&band] {
+        const auto x = vector{1.0, -1.0, 2.0, 0.5};
+        const auto expected = vector{3.0, 0.0, 11.5, 9.5};
+
+        expect(eq(band * x, expected));
+        expect(eq(opt::to_csc(band) * x, expected));
+        expect(eq(opt::multiply(band, x, opt::parallel{}), expected));
+
+        // Rows of a large matrix are split between threads
+        const auto n = std::size_t{10000};
+        auto e = entries{};
+        for (std::size_t i{0}; i < n; ++i) {
+            e.emplace_back(i, i);
+            e.emplace_back(i, (i + 7) % n);
+        }
+        const auto pattern = opt::sparsity_pattern::from_entries(n, n, e);
+        const auto m = opt::csr_matrix<double>{
+            pattern, std::vector<double>(pattern.nonzeros(), 1.0)};
+        const auto y = opt::multiply(
+            m, opt::dyn_vector<double>(n, 1.0), opt::parallel{64});
+        expect(eq(y, opt::dyn_vector<double>(n, 2.0)));
+    };
+
+    test("sparse matrix trace") = [&band] {
+        expect(eq(opt::trace(band), 22.0));
+        expect(eq(opt::trace(opt::to_csc(band)), 22.0));
+    };
+
+    test("sparse matrix minimum degree ordering") = [] {
+        // Eliminating the center of a star first fills the whole matrix,
+        // eliminating it after the leaves doesn't fill anything. Once a
+        // single leaf is left, it ties with the center.
+        auto e = entries{};
+        for (std::size_t i{0}; i < 6; ++i) {
+            e.emplace_back(i, i);
+            if (i > 0) {
+                e.emplace_back(0, i);
+                e.emplace_back(i, 0);
+            }
+        }
+        const auto star = opt::sparsity_pattern::from_entries(6, 6, e);
+
+        const auto order = opt::minimum_degree_ordering(star);
+        expect(eq(order, std::vector<std::size_t>{1, 2, 3, 4, 0, 5}));
+
+        const auto s = opt::analyze_cholesky(star);
+        expect(eq(s.permutation, order));
+        expect(eq(s.factor.nonzeros(), std::size_t{6 + 5}));
+        expect(eq(s.parent, std::vector<std::size_t>{4, 4, 4, 4, 5, 6}));
+    };
+
+    test("sparse matrix cholesky") = [&band] {
+        auto f = opt::sparse_cholesky<double>{
+            opt::analyze_cholesky(band.pattern)};
+        expect(opt::cholesky(band, f) >> fatal);
+
+        // Agrees with the dense factorization
+        using V = vector<double, 4>;
+        auto dense = opt::matrix<V, 4>{};
+        for (std::size_t i{0}; i < 4; ++i) {
+            for (std::size_t j{0}; j < 4; ++j) {
+                dense[{i, j}] = band[{i, j}];
+            }
+        }
+        const auto l = dense;
+        expect(opt::cholesky(dense) >> fatal);
+
+        const auto b = V{1.0, 2.0, 3.0, 4.0};
+        const auto x = opt::cholesky_solve(f, b);
+        expect(opt::close_to(x, opt::cholesky_solve(dense, b), 1e-12));
+        expect(opt::close_to(band * x, b, 1e-12));
+        expect(opt::close_to(l * x, b, 1e-12));
+
+        // Only the values change
+        auto scaled = band;
+        for (auto& v : scaled.values) {
+            v *= 2.0;
+        }
+        expect(opt::cholesky(scaled, f) >> fatal);
+        expect(opt::close_to(opt::cholesky_solve(f, b), 0.5 * x, 1e-12));
+    };
+
+    test("sparse matrix modified cholesky") = [&band] {
+        auto indefinite = band;
+        indefinite.values[0] = -4.0;
+
+        auto f = opt::sparse_cholesky<double>{
+            opt::analyze_cholesky(indefinite.pattern)};
+        expect(not opt::cholesky(indefinite, f));
+
+        const auto tau = opt::modified_cholesky(indefinite, f);
+        expect(gt(tau, 4.0));
+        expect(opt::cholesky(indefinite, f, tau));
+        expect(eq(opt::modified_cholesky(band, f), 0.0));
+
+        // Fails without looping forever on NaN entries
+        auto undefined = band;
+        undefined.values[1] = std::numeric_limits<double>::quiet_NaN();
+        undefined.values[2] = undefined.values[1];
+        const auto nan_tau = opt::modified_cholesky(undefined, f);
+        expect(nan_tau != nan_tau);
+    };
+
+    test("sparse matrix large cholesky") = [] {
+        // 2D Laplacian on a 30x30 grid, with a fill-reducing ordering
+        constexpr std::size_t side{30};
+        constexpr auto n = side * side;
+
+        auto e = entries{};
+        auto v = std::vector<double>{};
+        for (std::size_t i{0}; i < n; ++i) {
+            e.emplace_back(i, i);
+            if (i % side + 1 < side) {
+                e.emplace_back(i, i + 1);
+                e.emplace_back(i + 1, i);
+            }
+            if (i + side < n) {
+                e.emplace_back(i, i + side);
+                e.emplace_back(i + side, i);
+            }
+        }
+        const auto pattern = opt::sparsity_pattern::from_entries(n, n, e);
+        auto a = opt::csr_matrix<double>{pattern,
+                                         std::vector<double>(e.size())};
+        for (std::size_t i{0}; i < n; ++i) {
+            for (auto k = pattern.offsets[i]; k < pattern.offsets[i + 1];
+                 ++k) {
+                a.values[k] = pattern.indices[k] == i ? 4.1 : -1.0;
+            }
+        }
+
+        auto f = opt::sparse_cholesky<double>{opt::analyze_cholesky(pattern)};
+        expect(opt::cholesky(a, f) >> fatal);
+
+        // The natural ordering fills the band of width `side`
+        expect(lt(f.symbolic.factor.nonzeros(), n * side / 2));
+
+        auto b = opt::dyn_vector<double>(n);
+        for (std::size_t i{0}; i < n; ++i) {
+            b[i] = static_cast<double>(i % 7) - 3.0;
+        }
+        const auto x = opt::cholesky_solve(f, b);
+        expect(opt::close_to(a * x, b, 1e-10));
+    };
+}
+
+// NOLINTEND(readability-magic-numbers)
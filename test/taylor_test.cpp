@@ -0,0 +1,124 @@
+#include "src/convopt.hpp"
+#include "src/math.hpp"
+#include "src/spaces.hpp"
+#include "src/taylor.hpp"
+
+#include "boost/ut.hpp"
+
+#include <cmath>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+auto main() -> int
+{
+    using namespace boost::ut;
+    using opt::point;
+    using opt::vector;
+
+    using T3 = opt::taylor<double, 3>;
+    using T5 = opt::taylor<double, 5>;
+
+    constexpr double tol{1e-12};
+    constexpr auto t = T5::variable(0.0);
+
+    static_assert(opt::Arithmetic<T3>);
+    static_assert(opt::Taylor<T3>);
+    static_assert(not opt::Real<T3>);
+
+    test("taylor arithmetic") = [&t] {
+        // (1 + t)^2 = 1 + 2t + t^2
+        constexpr auto s = (T5{1.0} + t) * (T5{1.0} + t);
+        expect(constant<s == T5{{1.0, 2.0, 1.0, 0.0, 0.0, 0.0}}>);
+
+        // 1 / (1 - t) = 1 + t + t^2 + ...
+        constexpr auto g = T5{1.0} / (T5{1.0} - t);
+        expect(constant<g == T5{{1.0, 1.0, 1.0, 1.0, 1.0, 1.0}}>);
+        expect(constant<g * (T5{1.0} - t) == T5{1.0}>);
+
+        // Terms beyond the order are dropped
+        constexpr auto u = T3::variable(2.0);
+        expect(constant<u * u * u * u == T3{{16.0, 32.0, 24.0, 8.0}}>);
+        expect(constant<(u * u * u).derivative(3) == 6.0>);
+        expect(constant<(-u).derivative(1) == -1.0>);
+    };
+
+    test("taylor elementary series") = [&t, tol] {
+        constexpr auto e = opt::exp(t);
+        constexpr auto l = opt::log(T5{1.0} + t);
+        constexpr auto s = opt::sin(t);
+        constexpr auto c = opt::cos(t);
+
+        expect(constant<opt::close_to(
+                   e,
+                   T5{{1.0, 1.0, 1.0 / 2, 1.0 / 6, 1.0 / 24, 1.0 / 120}},
+                   tol)>);
+        expect(constant<opt::close_to(
+                   l,
+                   T5{{0.0, 1.0, -1.0 / 2, 1.0 / 3, -1.0 / 4, 1.0 / 5}},
+                   tol)>);
+        expect(constant<opt::close_to(
+                   s, T5{{0.0, 1.0, 0.0, -1.0 / 6, 0.0, 1.0 / 120}}, tol)>);
+        expect(constant<opt::close_to(
+                   c, T5{{1.0, 0.0, -1.0 / 2, 0.0, 1.0 / 24, 0.0}}, tol)>);
+
+        // Inverse functions and identities hold to the order of the series
+        expect(constant<opt::close_to(opt::log(e), t, tol)>);
+        expect(constant<opt::close_to(s * s + c * c, T5{1.0}, tol)>);
+
+        // (1 + t)^(1/2) has binomial coefficients
+        constexpr auto v = T5{1.0} + t;
+        expect(constant<opt::close_to(
+                   opt::sqrt(v),
+                   T5{{1.0, 0.5, -1.0 / 8, 1.0 / 16, -5.0 / 128, 7.0 / 256}},
+                   tol)>);
+        expect(constant<opt::close_to(opt::pow(v, 3.0), v * v * v, tol)>);
+        expect(constant<opt::close_to(
+                   opt::pow(2.0, t), opt::exp(t * T5{opt::log(2.0)}), tol)>);
+    };
+
+    test("taylor third derivative") = [tol] {
+        // d^3/dt^3 sin(exp(t)) = -cos(e^t) e^3t - 3 sin(e^t) e^2t
+        //                        + cos(e^t) e^t
+        constexpr auto f = [](double x) {
+            const auto u = T3::variable(x);
+            return opt::sin(opt::exp(u)).derivative(3);
+        };
+        const auto expected = [](double x) {
+            const auto e = std::exp(x);
+            return -std::cos(e) * e * e * e - 3 * std::sin(e) * e * e +
+                   std::cos(e) * e;
+        };
+
+        expect(constant<(opt::stdx::abs(f(0.0) + 3 * opt::sin(1.0)) < tol)>);
+        expect(le(std::abs(f(0.5) - expected(0.5)), tol));
+    };
+
+    test("taylor directional derivatives") = [tol] {
+        constexpr auto cost = []<opt::Point P>(const P& x) {
+            using S = opt::scalar_t<P>;
+            return (S{1} - x[0]) * (S{1} - x[0]) +
+                   S{100} * (x[1] - x[0] * x[0]) * (x[1] - x[0] * x[0]);
+        };
+
+        constexpr point p{0.5, 2.0};
+        constexpr vector d{1.0, -1.0};
+        constexpr auto r = opt::directional_derivatives<4>(p, cost, d);
+
+        // Agrees with the gradient and Hessian from dual numbers
+        constexpr auto g = opt::gradient(p, cost);
+        constexpr auto h = opt::hessian(p, cost);
+
+        expect(constant<r[0] == cost(p)>);
+        expect(constant<opt::stdx::abs(r[1] - (g[0] * d[0] + g[1] * d[1])) <
+                        tol>);
+        expect(constant<opt::stdx::abs(
+                            r[2] - (h[0][0] * d[0] * d[0] +
+                                    2 * h[0][1] * d[0] * d[1] +
+                                    h[1][1] * d[1] * d[1])) < tol>);
+
+        // The cost is a quartic in t with leading coefficient 100 d0^4
+        expect(constant<opt::stdx::abs(r[4] - 2400.0) < tol>);
+    };
+}
+
+// NOLINTEND(readability-magic-numbers)
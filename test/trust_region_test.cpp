@@ -0,0 +1,135 @@
+#include "src/convopt.hpp"
+#include "src/math.hpp"
+#include "src/solver_options.hpp"
+#include "src/spaces.hpp"
+#include "src/trust_region.hpp"
+
+#include "boost/ut.hpp"
+
+#include <cstddef>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+auto main() -> int
+{
+    using namespace boost::ut;
+    using opt::point;
+
+    constexpr auto rosenbrock = []<opt::Point P>(const P& x) {
+        using T = opt::scalar_t<P>;
+
+        const auto a = T{1} - x[0];
+        const auto b = x[1] - x[0] * x[0];
+        return a * a + T{100} * b * b;
+    };
+
+    // Chained Rosenbrock, of any dimension
+    constexpr auto chained = []<opt::Point P>(const P& x) {
+        using T = opt::scalar_t<P>;
+
+        auto acc = T{};
+        for (std::size_t i{0}; i + 1 < opt::dimension(x); ++i) {
+            const auto a = T{1} - x[i];
+            const auto b = x[i + 1] - x[i] * x[i];
+            acc += a * a + T{100} * b * b;
+        }
+        return acc;
+    };
+
+    constexpr auto tight = opt::solver_options<double>{
+        .gradient_tolerance = 1e-8, .max_iterations = 200};
+
+    test("trust region dogleg") = [&] {
+        constexpr auto r =
+            opt::trust_region_dogleg(point{-1.2, 1.0}, rosenbrock, tight);
+        expect(constant<r.reason == opt::stop_reason::gradient_tolerance>);
+        expect(constant<opt::close_to(r.x, point{1.0, 1.0}, 1e-6)>);
+        expect(constant<eq(r.value, rosenbrock(r.x))>);
+        expect(constant<eq(r.gradient, opt::gradient(r.x, rosenbrock))>);
+
+        // The Hessian is indefinite at the start
+        constexpr auto s =
+            opt::trust_region_dogleg(point{0.0, 1.0}, rosenbrock, tight);
+        expect(constant<s.converged()>);
+        expect(constant<opt::close_to(s.x, point{1.0, 1.0}, 1e-6)>);
+    };
+
+    test("trust region steihaug") = [&] {
+        constexpr auto r =
+            opt::trust_region_steihaug(point{-1.2, 1.0}, rosenbrock, tight);
+        expect(constant<r.reason == opt::stop_reason::gradient_tolerance>);
+        expect(constant<opt::close_to(r.x, point{1.0, 1.0}, 1e-6)>);
+
+        constexpr auto s =
+            opt::trust_region_steihaug(point{0.0, 1.0}, rosenbrock, tight);
+        expect(constant<opt::close_to(s.x, point{1.0, 1.0}, 1e-6)>);
+
+        const auto p = point{1.3, 0.8, 0.8, 1.3, 0.8, 0.8};
+        const auto ones = point{1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
+        expect(opt::close_to(
+            opt::trust_region_steihaug(p, chained, tight).x, ones, 1e-8));
+        expect(opt::close_to(
+            opt::trust_region_dogleg(p, chained, tight).x, ones, 1e-8));
+    };
+
+    test("trust region radius") = [&] {
+        // The first step stays in the initial region, on its boundary
+        const auto p = point{-1.2, 1.0};
+        const auto one = opt::solver_options<double>{.max_iterations = 1};
+        const auto small = opt::trust_region_options<double>{
+            .initial_radius = 0.01};
+
+        const auto d = opt::trust_region_dogleg(p, rosenbrock, one, small);
+        const auto s = opt::trust_region_steihaug(p, rosenbrock, one, small);
+        expect(d.reason == opt::stop_reason::max_iterations);
+        expect(eq(d.iterations, std::size_t{1}));
+        expect(le(opt::stdx::abs(opt::stdx::sqrt(opt::norm(d.x - p)) - 0.01),
+                  1e-12));
+        expect(le(opt::stdx::abs(opt::stdx::sqrt(opt::norm(s.x - p)) - 0.01),
+                  1e-12));
+        expect(lt(d.value, rosenbrock(p)));
+        expect(lt(s.value, rosenbrock(p)));
+    };
+
+    test("trust region undefined hessian") = [] {
+        // The cost and its derivatives are NaN at the start
+        const auto p = point{-1.0, 1.0};
+        const auto r = opt::trust_region_dogleg(
+            p, []<opt::Point P>(const P& x) {
+                return opt::sqrt(x[0]) + x[1] * x[1];
+            });
+        expect(r.reason == opt::stop_reason::trust_region_failed);
+        expect(eq(r.x, p));
+    };
+
+    test("trust region workspace") = [&] {
+        // Solves from several points reuse the same buffers
+        auto w = opt::dogleg_workspace<point<double, 2>>{};
+        for (const auto& p : {point{-1.2, 1.0}, point{0.0, 1.0}}) {
+            const auto r = opt::trust_region_dogleg(p, rosenbrock, w, tight);
+            expect(eq(r.x, opt::trust_region_dogleg(p, rosenbrock, tight).x));
+        }
+
+        const auto start = [](double offset) {
+            auto x = opt::dyn_point<double>(200);
+            for (std::size_t i{0}; i < x.size(); ++i) {
+                x[i] = i % 3 == 0 ? 1.3 + offset : 0.8;
+            }
+            return x;
+        };
+
+        auto v = opt::steihaug_workspace{start(0.0)};
+        for (const auto offset : {0.0, 0.1}) {
+            const auto r =
+                opt::trust_region_steihaug(start(offset), chained, v, tight);
+            expect(r.converged());
+            expect(opt::close_to(
+                r.x, opt::dyn_point<double>(200, 1.0), 1e-8));
+            expect(eq(r.x,
+                      opt::trust_region_steihaug(start(offset), chained, tight)
+                          .x));
+        }
+    };
+}
+
+// NOLINTEND(readability-magic-numbers)